@@ -0,0 +1,42 @@
+#include "batch.hpp"
+
+#include <algorithm>
+#include <functional>
+
+namespace interval_mist::batch {
+
+// Storage a thread reuses from one instance to the next
+struct Scratch {
+  std::vector<Interval> sorted;
+  solvers::registry::Scratch solver;
+};
+
+std::vector<std::optional<SpanningTree>>
+solve(std::span<const std::vector<Interval>> instances,
+      const solvers::registry::Entry &entry, thread_pool::ThreadPool &pool) {
+  std::vector<std::optional<SpanningTree>> result(instances.size());
+  std::vector<Scratch> scratch(pool.num_threads());
+  pool.parallel_for(instances.size(), [&](size_t k, size_t slot) {
+    std::span<const Interval> is = instances[k];
+    if (std::adjacent_find(is.begin(), is.end(), std::greater_equal()) !=
+        is.end()) {
+      std::vector<Interval> &sorted = scratch[slot].sorted;
+      sorted.assign(is.begin(), is.end());
+      std::sort(sorted.begin(), sorted.end());
+      sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+      is = sorted;
+    }
+    if (solvers::registry::fits(entry, is))
+      result[k] = solvers::registry::run(entry, is, scratch[slot].solver);
+  });
+  return result;
+}
+
+std::vector<std::optional<SpanningTree>>
+solve(std::span<const std::vector<Interval>> instances,
+      const solvers::registry::Entry &entry) {
+  thread_pool::ThreadPool pool;
+  return solve(instances, entry, pool);
+}
+
+} // namespace interval_mist::batch
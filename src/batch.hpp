@@ -0,0 +1,35 @@
+#pragma once
+
+#include "interval.hpp"
+#include "solvers/registry.hpp"
+#include "spanning_tree.hpp"
+#include "thread_pool.hpp"
+
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace interval_mist::batch {
+
+using Interval = interval_mist::interval::Interval;
+using SpanningTree = interval_mist::graph::SpanningTree;
+
+// Solves many independent instances with entry across pool, returning their
+// trees in input order. Instances may be in any order and repeat intervals.
+// Each thread keeps scratch space that it reuses from one instance to the
+// next: a buffer that instances not distinct and in canonical order are sorted
+// into, and the IntervalGraph or CompactGraph that entry takes, if it takes
+// one. Solvers still allocate their own working memory and the trees they
+// return, and a Graph input is built afresh for each instance. Each result is
+// what registry::run gives for the instance, or nothing if the instance is
+// beyond the limits of entry.
+std::vector<std::optional<SpanningTree>>
+solve(std::span<const std::vector<Interval>> instances,
+      const solvers::registry::Entry &entry, thread_pool::ThreadPool &pool);
+
+// As above, with a thread per core
+std::vector<std::optional<SpanningTree>>
+solve(std::span<const std::vector<Interval>> instances,
+      const solvers::registry::Entry &entry);
+
+} // namespace interval_mist::batch
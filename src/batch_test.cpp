@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+
+#include "batch.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace interval_mist::batch {
+
+namespace registry = solvers::registry;
+
+static std::vector<std::vector<Interval>> instances(size_t num) {
+  std::vector<std::vector<Interval>> result;
+  for (size_t k = 0; k < num; ++k) {
+    result.push_back(interval::random_connected_intervals(k, 1 + k % 12));
+  }
+  return result;
+}
+
+TEST(BatchTest, Empty) {
+  EXPECT_TRUE(solve({}, *registry::find("greedy_sorted")).empty());
+}
+
+TEST(BatchTest, SameAsOneAtATime) {
+  auto is = instances(200);
+  for (const char *name : {"greedy_sorted", "path_cover", "dp"}) {
+    const registry::Entry &entry = *registry::find(name);
+    thread_pool::ThreadPool pool(4);
+    auto trees = solve(is, entry, pool);
+    ASSERT_EQ(is.size(), trees.size());
+    for (size_t k = 0; k < is.size(); ++k) {
+      auto tree = registry::run(entry, is[k]);
+      ASSERT_EQ(tree.has_value(), trees[k].has_value()) << name << " " << k;
+      if (tree) {
+        EXPECT_EQ(tree->to_graph(), trees[k]->to_graph()) << name << " " << k;
+      }
+    }
+  }
+}
+
+TEST(BatchTest, SortsAndDeduplicates) {
+  auto is = instances(50);
+  std::vector<std::vector<Interval>> shuffled;
+  for (auto instance : is) {
+    std::reverse(instance.begin(), instance.end());
+    instance.push_back(instance.front());
+    shuffled.push_back(instance);
+  }
+  const registry::Entry &greedy = *registry::find("greedy_sorted");
+  thread_pool::ThreadPool pool(3);
+  auto lhs = solve(is, greedy, pool), rhs = solve(shuffled, greedy, pool);
+  for (size_t k = 0; k < is.size(); ++k) {
+    ASSERT_TRUE(rhs[k].has_value());
+    EXPECT_EQ(lhs[k]->to_graph(), rhs[k]->to_graph());
+  }
+}
+
+TEST(BatchTest, BeyondLimits) {
+  std::vector<std::vector<Interval>> is = {
+      interval::random_connected_intervals(0, 5),
+      interval::random_connected_intervals(1, 200)};
+  auto trees = solve(is, *registry::find("dp"));
+  EXPECT_TRUE(trees[0].has_value());
+  EXPECT_FALSE(trees[1].has_value());
+}
+
+} // namespace interval_mist::batch
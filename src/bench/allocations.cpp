@@ -0,0 +1,31 @@
+#include "allocations.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Kept apart from any code using the heap, so the compiler never sees both
+// the replaced operators and the calls to them
+
+namespace interval_mist::bench {
+
+static std::atomic<size_t> allocations = 0, allocated_bytes = 0;
+
+size_t num_allocations() { return allocations.load(); }
+
+size_t num_allocated_bytes() { return allocated_bytes.load(); }
+
+} // namespace interval_mist::bench
+
+void *operator new(size_t size) {
+  using namespace interval_mist::bench;
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+  if (void *ptr = std::malloc(size ? size : 1))
+    return ptr;
+  throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+
+void operator delete(void *ptr, size_t) noexcept { std::free(ptr); }
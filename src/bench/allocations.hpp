@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstddef>
+
+namespace interval_mist::bench {
+
+// Totals over all calls so far to the global operator new, which the
+// benchmark binary replaces to count them
+size_t num_allocations();
+
+size_t num_allocated_bytes();
+
+} // namespace interval_mist::bench
@@ -0,0 +1,153 @@
+#include "../compact_graph.hpp"
+#include "../graph/bfs.hpp"
+#include "../graph/hamiltonian.hpp"
+#include "../graph/tree_transform.hpp"
+#include "../interval_graph.hpp"
+#include "../thread_pool.hpp"
+#include "inputs.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <optional>
+
+namespace interval_mist::bench {
+
+static void BM_interval_graph_from_set(benchmark::State &state) {
+  auto is = benchmark_intervals(state);
+  AllocationCounter allocs;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Graph::interval_graph_from_set(is));
+  }
+  allocs.report(state, is.size());
+}
+BENCHMARK(BM_interval_graph_from_set)->Apply([](auto *b) {
+  sizes_and_families(b, large_sizes);
+});
+
+// Flat adjacency arrays filled across a thread per core
+static void BM_compact_graph(benchmark::State &state) {
+  auto is = benchmark_intervals(state);
+  graph::IntervalGraph ig(is);
+  thread_pool::ThreadPool pool;
+  AllocationCounter allocs;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(graph::CompactGraph(ig, pool));
+  }
+  allocs.report(state, is.size());
+}
+BENCHMARK(BM_compact_graph)->Apply([](auto *b) {
+  sizes_and_families(b, large_sizes);
+});
+
+// Degrees alone, which give the edge count without listing any edges
+static void BM_degrees(benchmark::State &state) {
+  auto is = benchmark_intervals(state);
+  graph::IntervalGraph ig(is);
+  AllocationCounter allocs;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ig.degrees());
+  }
+  allocs.report(state, is.size());
+}
+BENCHMARK(BM_degrees)->Apply([](auto *b) {
+  sizes_and_families(b, large_sizes);
+});
+
+static void BM_bfs_parents(benchmark::State &state) {
+  auto g = benchmark_graph(state);
+  AllocationCounter allocs;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(graph::bfs::bfs_parents(g, *g.verts.begin()));
+  }
+  allocs.report(state, g.verts.size());
+}
+BENCHMARK(BM_bfs_parents)->Apply([](auto *b) {
+  sizes_and_families(b, large_sizes);
+});
+
+// Built once outside the loop, as passing a Graph would copy its sets
+static void BM_hamiltonian(benchmark::State &state) {
+  graph::IntervalGraph g(benchmark_intervals(state));
+  AllocationCounter allocs;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(graph::hamiltonian::hamiltonian(g));
+  }
+  allocs.report(state, g.num_verts());
+}
+BENCHMARK(BM_hamiltonian)->Apply([](auto *b) {
+  sizes_and_families(b, large_sizes);
+});
+
+// The same on the sorted intervals alone, with no graph built
+static void BM_hamiltonian_path(benchmark::State &state) {
+  auto set = benchmark_intervals(state);
+  std::vector<Interval> is(set.begin(), set.end());
+  AllocationCounter allocs;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(graph::hamiltonian::hamiltonian_path(is));
+  }
+  allocs.report(state, is.size());
+}
+BENCHMARK(BM_hamiltonian_path)->Apply([](auto *b) {
+  sizes_and_families(b, large_sizes);
+});
+
+static void BM_hamiltonian_cycle(benchmark::State &state) {
+  auto set = benchmark_intervals(state);
+  std::vector<Interval> is(set.begin(), set.end());
+  AllocationCounter allocs;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(graph::hamiltonian::has_hamiltonian_cycle(is));
+  }
+  allocs.report(state, is.size());
+}
+BENCHMARK(BM_hamiltonian_cycle)->Apply([](auto *b) {
+  sizes_and_families(b, large_sizes);
+});
+
+// Interval graph from the first seed whose LRE (the interval with the leftmost
+// right endpoint) has more than one neighbour, as otherwise every spanning tree
+// has it as a leaf and there is nothing to transform. Seeds are spread out, as
+// the generators' linear congruential engines start alike from nearby seeds.
+static std::optional<Graph> lre_internal_graph(benchmark::State &state) {
+  for (size_t k = 0; k < 64; ++k) {
+    auto is = benchmark_intervals(state, 1 + (k * 0x9E3779B9ull) % 0x7FFFFFFF);
+    if (graph::IntervalGraph(is).degree(0) > 1)
+      return Graph::interval_graph_from_set(is);
+  }
+  return {};
+}
+
+// Transforms a BFS tree rooted at the LRE, so the LRE is adjacent to all its
+// neighbours. A greedy tree would not do, as it has the LRE as a leaf already.
+static void BM_lre_leaf_transform(benchmark::State &state) {
+  auto g = lre_internal_graph(state);
+  if (!g) {
+    state.SkipWithError("LRE is a leaf of every spanning tree");
+    return;
+  }
+  Graph tree({}, {});
+  for (auto [v, parent] : graph::bfs::bfs_parents(*g, *g->verts.begin())) {
+    tree.insert_vertex(v);
+    if (v != parent)
+      tree.insert_edge(v, parent);
+  }
+  if (tree.verts != g->verts) {
+    state.SkipWithError("no spanning tree");
+    return;
+  }
+  if (graph::CompactGraph(tree).degree(0) == 1) {
+    state.SkipWithError("LRE is already a leaf");
+    return;
+  }
+  AllocationCounter allocs;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(graph::tree_transform::lre_leaf_transform(tree));
+  }
+  allocs.report(state, tree.verts.size());
+}
+BENCHMARK(BM_lre_leaf_transform)->Apply([](auto *b) {
+  sizes_and_families(b, {16, 64, 256, 1024});
+});
+
+} // namespace interval_mist::bench
@@ -0,0 +1,44 @@
+#include "inputs.hpp"
+
+#include "allocations.hpp"
+
+namespace interval_mist::bench {
+
+namespace intervals = interval_mist::generators::intervals;
+
+std::set<Interval> benchmark_intervals(benchmark::State &state, size_t seed) {
+  auto family = intervals::families[state.range(1)];
+  state.SetLabel(intervals::name(family));
+  auto is = intervals::generate(family, seed, state.range(0));
+  return std::set<Interval>(is.begin(), is.end());
+}
+
+Graph benchmark_graph(benchmark::State &state) {
+  return Graph::interval_graph_from_set(benchmark_intervals(state));
+}
+
+void sizes_and_families(benchmark::internal::Benchmark *b,
+                        const std::vector<int64_t> &sizes) {
+  b->ArgNames({"verts", "family"});
+  for (size_t family = 0; family < std::size(intervals::families); ++family) {
+    for (int64_t n : sizes) {
+      b->Args({n, static_cast<int64_t>(family)});
+    }
+  }
+}
+
+AllocationCounter::AllocationCounter()
+    : start_allocs(num_allocations()), start_bytes(num_allocated_bytes()) {}
+
+void AllocationCounter::report(benchmark::State &state,
+                               size_t num_verts) const {
+  using benchmark::Counter;
+  state.counters["allocs"] =
+      Counter(num_allocations() - start_allocs, Counter::kAvgIterations);
+  state.counters["alloc_bytes"] =
+      Counter(num_allocated_bytes() - start_bytes, Counter::kAvgIterations,
+              Counter::OneK::kIs1024);
+  state.SetItemsProcessed(state.iterations() * num_verts);
+}
+
+} // namespace interval_mist::bench
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "../graph.hpp"
+#include "../generators/intervals.hpp"
+#include "../interval.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <vector>
+
+namespace interval_mist::bench {
+
+using Graph = interval_mist::graph::Graph;
+using Interval = interval_mist::interval::Interval;
+
+// Input for a benchmark taking the vertex count and index of an interval
+// family as its two arguments, labelling the run with the family's name
+std::set<Interval> benchmark_intervals(benchmark::State &state,
+                                       size_t seed = 1);
+
+Graph benchmark_graph(benchmark::State &state);
+
+// Runs a benchmark over every pair of the given vertex counts and interval
+// family
+void sizes_and_families(benchmark::internal::Benchmark *b,
+                        const std::vector<int64_t> &sizes);
+
+// Vertex counts of linear and near linear time routines, up to the largest
+// inputs we see in practice
+const std::vector<int64_t> large_sizes = {16, 64, 256, 1024, 4096};
+
+// Heap allocations made between construction and report
+struct AllocationCounter {
+  size_t start_allocs, start_bytes;
+
+  AllocationCounter();
+
+  // Adds per iteration allocation counters, and items per second counting
+  // each vertex as an item
+  void report(benchmark::State &state, size_t num_verts) const;
+};
+
+} // namespace interval_mist::bench
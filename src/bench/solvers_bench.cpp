@@ -0,0 +1,93 @@
+#include "../batch.hpp"
+#include "../solvers.hpp"
+#include "../solvers/registry.hpp"
+#include "inputs.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <thread>
+#include <vector>
+
+namespace interval_mist::bench {
+
+static void BM_greedy(benchmark::State &state) {
+  auto g = benchmark_graph(state);
+  AllocationCounter allocs;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(solvers::greedy::interval_mist_greedy(g));
+  }
+  allocs.report(state, g.verts.size());
+}
+BENCHMARK(BM_greedy)->Apply([](auto *b) {
+  sizes_and_families(b, large_sizes);
+});
+
+// Exponential in the number of vertices, so only small inputs
+static void BM_dp(benchmark::State &state) {
+  auto g = benchmark_graph(state);
+  AllocationCounter allocs;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(solvers::dp::interval_mist_dp(g));
+  }
+  allocs.report(state, g.verts.size());
+}
+BENCHMARK(BM_dp)->Apply([](auto *b) {
+  sizes_and_families(b, {4, 8, 12});
+});
+
+// Exponential in the number of edges, though pruned well on these inputs
+static void BM_naive(benchmark::State &state) {
+  auto g = benchmark_graph(state);
+  AllocationCounter allocs;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(solvers::naive::interval_mist_naive(g));
+  }
+  allocs.report(state, g.verts.size());
+}
+BENCHMARK(BM_naive)->Apply([](auto *b) {
+  sizes_and_families(b, {4, 8, 12});
+});
+
+static void BM_path_cover(benchmark::State &state) {
+  auto g = benchmark_graph(state);
+  AllocationCounter allocs;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(solvers::path_cover::interval_mist_path_cover(g));
+  }
+  allocs.report(state, g.verts.size());
+}
+BENCHMARK(BM_path_cover)->Apply([](auto *b) {
+  sizes_and_families(b, large_sizes);
+});
+
+// Many small instances at once, by solver and number of threads, counting
+// each instance as an item
+static void BM_batch(benchmark::State &state) {
+  namespace registry = solvers::registry;
+  const registry::Entry &entry =
+      registry::entries()[size_t(state.range(0))];
+  state.SetLabel(std::string(entry.name));
+  std::vector<std::vector<Interval>> is;
+  for (size_t k = 0; k < 4096; ++k) {
+    is.push_back(interval::random_connected_intervals(k, 32));
+  }
+  thread_pool::ThreadPool pool(state.range(1));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(batch::solve(is, entry, pool));
+  }
+  state.SetItemsProcessed(state.iterations() * is.size());
+}
+BENCHMARK(BM_batch)->Apply([](auto *b) {
+  namespace registry = solvers::registry;
+  b->ArgNames({"solver", "threads"});
+  for (const char *name : {"greedy_sorted", "path_cover"}) {
+    int64_t solver = registry::find(name) - registry::entries().data();
+    for (int64_t threads = 1; threads <= std::thread::hardware_concurrency();
+         threads *= 2) {
+      b->Args({solver, threads});
+    }
+  }
+  b->UseRealTime();
+});
+
+} // namespace interval_mist::bench
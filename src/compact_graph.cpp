@@ -0,0 +1,161 @@
+#include "compact_graph.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+
+namespace interval_mist::graph {
+
+using Vertex = CompactGraph::Vertex;
+using Edge = CompactGraph::Edge;
+using Id = CompactGraph::Id;
+
+CompactGraph::CompactGraph(const Graph &g)
+    : verts(g.verts.begin(), g.verts.end()), offsets(g.verts.size() + 1) {
+  assert(verts.size() <= std::numeric_limits<Id>::max());
+
+  std::unordered_map<Vertex, Id> ids;
+  for (Id u = 0; u < verts.size(); ++u) {
+    ids.emplace(verts[u], u);
+  }
+
+  std::vector<std::pair<Id, Id>> edges;
+  edges.reserve(g.edges.size());
+  for (Edge e : g.edges) {
+    edges.emplace_back(ids.at(e.src), ids.at(e.dst));
+  }
+
+  // Edges are ordered by (src, dst) so filling rows in edge order leaves
+  // every row sorted: row u receives all smaller ids before any larger ones
+  for (auto [u, v] : edges) {
+    ++offsets[u + 1];
+    ++offsets[v + 1];
+  }
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+  targets.resize(offsets.back());
+  std::vector<size_t> fill(offsets.begin(), offsets.end() - 1);
+  for (auto [u, v] : edges) {
+    targets[fill[u]++] = v;
+    targets[fill[v]++] = u;
+  }
+}
+
+CompactGraph::CompactGraph(const IntervalGraph &g) { assign(g); }
+
+CompactGraph::CompactGraph(const IntervalGraph &g,
+                           thread_pool::ThreadPool &pool)
+    : verts(g.vertices()), offsets(g.num_verts() + 1) {
+  // A few runs per thread, so that stealing can even out dense regions
+  size_t n = verts.size();
+  size_t num_runs = std::min(n, 4 * pool.num_threads());
+  auto for_each_vertex = [&](auto fn) {
+    pool.parallel_for(num_runs, [&](size_t r) {
+      for (Id u = n * r / num_runs; u < n * (r + 1) / num_runs; ++u) {
+        fn(u);
+      }
+    });
+  };
+
+  for_each_vertex([&](Id u) { offsets[u + 1] = g.degree(u); });
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+  targets.resize(offsets.back());
+  for_each_vertex([&](Id u) {
+    size_t fill = offsets[u];
+    g.find_neighbour(u, [&](Id v) {
+      targets[fill++] = v;
+      return false;
+    });
+    assert(fill == offsets[u + 1]);
+  });
+}
+
+void CompactGraph::assign(const IntervalGraph &g) {
+  verts.assign(g.vertices().begin(), g.vertices().end());
+  offsets.assign(g.num_verts() + 1, 0);
+  for (Id u = 0; u < verts.size(); ++u) {
+    offsets[u + 1] = offsets[u] + g.degree(u);
+  }
+
+  targets.clear();
+  targets.reserve(offsets.back());
+  for (Id u = 0; u < verts.size(); ++u) {
+    g.find_neighbour(u, [this](Id v) {
+      targets.push_back(v);
+      return false;
+    });
+  }
+  assert(targets.size() == offsets.back());
+}
+
+size_t CompactGraph::memory_bytes(size_t num_verts, size_t num_edges) {
+  return sizeof(CompactGraph) + num_verts * sizeof(Vertex) +
+         (num_verts + 1) * sizeof(size_t) + 2 * num_edges * sizeof(Id);
+}
+
+size_t CompactGraph::num_verts() const { return verts.size(); }
+
+size_t CompactGraph::num_edges() const { return targets.size() / 2; }
+
+const std::vector<Vertex> &CompactGraph::vertices() const { return verts; }
+
+const Vertex &CompactGraph::vertex(Id u) const { return verts[u]; }
+
+std::optional<Id> CompactGraph::id_of(const Vertex &v) const {
+  auto it = std::lower_bound(verts.begin(), verts.end(), v);
+  if (it == verts.end() || *it != v)
+    return {};
+  return it - verts.begin();
+}
+
+bool CompactGraph::adjacent(Id u, Id v) const {
+  auto row = neighbours(u);
+  return std::binary_search(row.begin(), row.end(), v);
+}
+
+size_t CompactGraph::degree(Id u) const { return offsets[u + 1] - offsets[u]; }
+
+std::span<const Id> CompactGraph::neighbours(Id u) const {
+  return {targets.data() + offsets[u], targets.data() + offsets[u + 1]};
+}
+
+bool CompactGraph::is_connected() const {
+  if (verts.empty())
+    return true;
+
+  std::vector<bool> seen(verts.size());
+  std::vector<Id> stack = {0};
+  seen[0] = true;
+  size_t num_seen = 1;
+
+  while (!stack.empty()) {
+    Id u = stack.back();
+    stack.pop_back();
+
+    for (Id v : neighbours(u)) {
+      if (seen[v])
+        continue;
+      seen[v] = true;
+      ++num_seen;
+      stack.push_back(v);
+    }
+  }
+
+  return num_seen == verts.size();
+}
+
+Graph CompactGraph::to_graph() const {
+  std::set<Edge> es;
+  for (Id u = 0; u < verts.size(); ++u) {
+    for (Id v : neighbours(u)) {
+      if (u < v)
+        es.emplace_hint(es.end(), verts[u], verts[v]);
+    }
+  }
+  return Graph(std::set<Vertex>(verts.begin(), verts.end()), es);
+}
+
+} // namespace interval_mist::graph
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "graph.hpp"
+#include "interval_graph.hpp"
+#include "thread_pool.hpp"
+
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace interval_mist::graph {
+
+// Frozen graph in compressed sparse row form. Vertices are dense ids in
+// canonical order and the neighbours of each vertex are stored contiguously,
+// sorted by id, so adjacency scans walk a flat array instead of tree nodes.
+struct CompactGraph {
+  using Vertex = Graph::Vertex;
+  using Edge = Graph::Edge;
+  using Id = uint32_t;
+
+  CompactGraph(const Graph &);
+
+  CompactGraph(const IntervalGraph &);
+
+  // As above, with rows counted and then filled in place across pool, each
+  // thread taking runs of consecutive vertices. The result is the same.
+  CompactGraph(const IntervalGraph &, thread_pool::ThreadPool &pool);
+
+  // Replaces the graph with g, refilling the rows in the storage already held
+  void assign(const IntervalGraph &g);
+
+  // Bytes held by a graph of this size, which with IntervalGraph::degrees
+  // tells whether one will fit in memory before building it
+  static size_t memory_bytes(size_t num_verts, size_t num_edges);
+
+  size_t num_verts() const;
+
+  size_t num_edges() const;
+
+  const std::vector<Vertex> &vertices() const;
+
+  const Vertex &vertex(Id) const;
+
+  std::optional<Id> id_of(const Vertex &) const;
+
+  bool adjacent(Id, Id) const;
+
+  size_t degree(Id) const;
+
+  // Neighbours of u in canonical order
+  std::span<const Id> neighbours(Id u) const;
+
+  // First neighbour of u in canonical order satisfying pred, if any
+  template <typename Pred>
+  std::optional<Id> find_neighbour(Id u, Pred pred) const {
+    for (Id v : neighbours(u)) {
+      if (pred(v))
+        return v;
+    }
+    return {};
+  }
+
+  bool is_connected() const;
+
+  Graph to_graph() const;
+
+private:
+  // Vertices in canonical order
+  std::vector<Vertex> verts;
+  // Neighbours of u are targets[offsets[u]] up to targets[offsets[u + 1]]
+  std::vector<size_t> offsets;
+  std::vector<Id> targets;
+};
+
+} // namespace interval_mist::graph
@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+
+#include "compact_graph.hpp"
+
+namespace interval_mist::graph {
+
+using Vertex = CompactGraph::Vertex;
+using Edge = CompactGraph::Edge;
+using Id = CompactGraph::Id;
+
+TEST(CompactGraphTest, Empty) {
+  CompactGraph g = CompactGraph(Graph({}, {}));
+  EXPECT_EQ(0, g.num_verts());
+  EXPECT_EQ(0, g.num_edges());
+  EXPECT_TRUE(g.is_connected());
+}
+
+TEST(CompactGraphTest, SimpleTree) {
+  Vertex a = Vertex(0, 2), b = Vertex(1, 3), c = Vertex(4, 5);
+  Graph g = Graph({a, b, c}, {Edge(a, b), Edge(a, c)});
+  CompactGraph cg = CompactGraph(g);
+  ASSERT_EQ(3, cg.num_verts());
+  EXPECT_EQ(2, cg.num_edges());
+  EXPECT_EQ(std::vector<Id>({1, 2}),
+            std::vector<Id>(cg.neighbours(0).begin(), cg.neighbours(0).end()));
+  EXPECT_EQ(1, cg.degree(2));
+  EXPECT_TRUE(cg.adjacent(2, 0));
+  EXPECT_FALSE(cg.adjacent(1, 2));
+  EXPECT_EQ(std::optional<Id>(2), cg.id_of(c));
+  EXPECT_TRUE(cg.is_connected());
+  EXPECT_EQ(g, cg.to_graph());
+}
+
+TEST(CompactGraphTest, Disconnected) {
+  Vertex a = Vertex(0, 2), b = Vertex(1, 3), c = Vertex(4, 5);
+  CompactGraph cg = CompactGraph(Graph({a, b, c}, {Edge(a, b)}));
+  EXPECT_FALSE(cg.is_connected());
+}
+
+TEST(CompactGraphTest, MatchesIntervalGraph) {
+  for (size_t seed = 0; seed < 20; ++seed) {
+    auto vs = interval::random_connected_interval_set(seed, 40);
+    Graph g = Graph::interval_graph_from_set(vs);
+    IntervalGraph ig = IntervalGraph(vs);
+    CompactGraph from_graph = CompactGraph(g);
+    CompactGraph from_interval_graph = CompactGraph(ig);
+    EXPECT_EQ(g, from_graph.to_graph());
+    EXPECT_EQ(g, from_interval_graph.to_graph());
+    for (Id u = 0; u < ig.num_verts(); ++u) {
+      auto row = from_graph.neighbours(u);
+      EXPECT_EQ(ig.neighbours(u), std::vector<Id>(row.begin(), row.end()));
+    }
+  }
+}
+
+TEST(CompactGraphTest, ParallelMatchesSerial) {
+  thread_pool::ThreadPool pool(4);
+  for (size_t num_verts : {0, 1, 2, 5, 300}) {
+    for (size_t seed = 0; seed < 5; ++seed) {
+      // Random sets are connected, so shift half of each to split it
+      std::vector<Vertex> vs;
+      for (Vertex v : interval::random_connected_intervals(seed, num_verts)) {
+        Vertex::Coord shift = vs.size() % 2 ? 4 * num_verts : 0;
+        vs.push_back(Vertex(v.lower + shift, v.upper + shift));
+      }
+      IntervalGraph ig = IntervalGraph(vs);
+      CompactGraph serial = CompactGraph(ig), parallel = CompactGraph(ig, pool);
+      ASSERT_EQ(serial.num_edges(), parallel.num_edges());
+      for (Id u = 0; u < ig.num_verts(); ++u) {
+        auto lhs = serial.neighbours(u), rhs = parallel.neighbours(u);
+        EXPECT_TRUE(std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
+      }
+    }
+  }
+}
+
+} // namespace interval_mist::graph
@@ -0,0 +1,122 @@
+#include "compress.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+
+namespace interval_mist::compress {
+
+using Coord = Interval::Coord;
+
+// Unsigned keys in the same order as the values they come from
+static uint64_t key(uint64_t v) { return v; }
+
+static uint64_t key(int64_t v) { return uint64_t(v) ^ uint64_t(1) << 63; }
+
+static uint64_t key(double v) {
+  // Negative values have their order reversed by the sign bit
+  uint64_t bits = std::bit_cast<uint64_t>(v == 0 ? 0.0 : v);
+  return bits >> 63 ? ~bits : bits | uint64_t(1) << 63;
+}
+
+static bool is_number(uint64_t) { return true; }
+
+static bool is_number(int64_t) { return true; }
+
+static bool is_number(double v) { return !std::isnan(v); }
+
+// Endpoint 2i is the left end of interval i and 2i + 1 its right
+struct Endpoint {
+  uint64_t key;
+  size_t index;
+};
+
+// Sorts by key a byte at a time from the least significant, skipping bytes
+// on which every key agrees
+static void radix_sort(std::vector<Endpoint> &items) {
+  std::vector<Endpoint> buffer(items.size());
+  for (unsigned shift = 0; shift < 64; shift += 8) {
+    std::array<size_t, 257> starts{};
+    for (const Endpoint &e : items) {
+      ++starts[(e.key >> shift & 0xff) + 1];
+    }
+    if (std::count(starts.begin(), starts.end(), items.size()) > 0)
+      continue;
+    std::partial_sum(starts.begin(), starts.end(), starts.begin());
+    for (const Endpoint &e : items) {
+      buffer[starts[e.key >> shift & 0xff]++] = e;
+    }
+    items.swap(buffer);
+  }
+}
+
+// Stable sort of order by coord(i) for i in order, with coords below m
+template <typename F>
+static void counting_sort(std::vector<size_t> &order, size_t m, F coord) {
+  std::vector<size_t> starts(m + 1), sorted(order.size());
+  for (size_t i : order) {
+    ++starts[coord(i) + 1];
+  }
+  std::partial_sum(starts.begin(), starts.end(), starts.begin());
+  for (size_t i : order) {
+    sorted[starts[coord(i)]++] = i;
+  }
+  order.swap(sorted);
+}
+
+template <typename T>
+std::optional<Compressed<T>> compress(std::span<const Raw<T>> is) {
+  std::vector<Endpoint> endpoints;
+  endpoints.reserve(2 * is.size());
+  for (size_t i = 0; i < is.size(); ++i) {
+    if (!is_number(is[i].lower) || !is_number(is[i].upper) ||
+        key(is[i].lower) > key(is[i].upper))
+      return {};
+    endpoints.push_back({key(is[i].lower), 2 * i});
+    endpoints.push_back({key(is[i].upper), 2 * i + 1});
+  }
+  radix_sort(endpoints);
+
+  Compressed<T> result;
+  std::vector<Coord> coords(endpoints.size());
+  for (size_t k = 0; k < endpoints.size(); ++k) {
+    const Endpoint &e = endpoints[k];
+    if (k == 0 || e.key != endpoints[k - 1].key) {
+      if (result.values.size() > std::numeric_limits<Coord>::max())
+        return {};
+      const Raw<T> &raw = is[e.index / 2];
+      result.values.push_back(e.index % 2 ? raw.upper : raw.lower);
+    }
+    coords[e.index] = result.values.size() - 1;
+  }
+
+  // Canonical order is by right endpoint, then left, so sort by left first
+  std::vector<size_t> order(is.size());
+  std::iota(order.begin(), order.end(), 0);
+  size_t m = result.values.size();
+  counting_sort(order, m, [&coords](size_t i) { return coords[2 * i]; });
+  counting_sort(order, m, [&coords](size_t i) { return coords[2 * i + 1]; });
+
+  result.intervals.reserve(is.size());
+  for (size_t i : order) {
+    Interval v(coords[2 * i], coords[2 * i + 1]);
+    if (result.intervals.empty() || result.intervals.back() != v)
+      result.intervals.push_back(v);
+  }
+  return result;
+}
+
+template std::optional<Compressed<int64_t>>
+compress(std::span<const Raw<int64_t>>);
+
+template std::optional<Compressed<uint64_t>>
+compress(std::span<const Raw<uint64_t>>);
+
+template std::optional<Compressed<double>>
+compress(std::span<const Raw<double>>);
+
+} // namespace interval_mist::compress
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "interval.hpp"
+
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace interval_mist::compress {
+
+using Interval = interval_mist::interval::Interval;
+
+// Interval with endpoints as they come from outside, such as 64-bit
+// timestamps or measurements. Closed at both ends, like Interval.
+template <typename T> struct Raw {
+  T lower, upper;
+
+  friend bool operator==(const Raw &, const Raw &) = default;
+};
+
+// Intervals over dense coordinates 0, 1, 2, ..., together with the original
+// value of each coordinate so that results can be reported in the input's own
+// terms. Coordinates keep the order of the values, so intervals meet exactly
+// when the originals do.
+template <typename T> struct Compressed {
+  // Distinct and in canonical order
+  std::vector<Interval> intervals;
+  // Value of each coordinate, increasing
+  std::vector<T> values;
+
+  Raw<T> original(Interval i) const {
+    return {values[i.lower], values[i.upper]};
+  }
+};
+
+// Replaces each endpoint of is by its rank among the distinct endpoints, then
+// sorts the intervals into canonical order and drops repeats. Both sorts are
+// LSD radix sorts, so this is O(n) for n intervals. Returns nothing if an
+// interval ends before it starts, an endpoint is NaN, or there are more
+// distinct endpoints than Coord can index. Zeroes of either sign are equal.
+// Defined for int64_t, uint64_t and double.
+template <typename T>
+std::optional<Compressed<T>> compress(std::span<const Raw<T>> is);
+
+} // namespace interval_mist::compress
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+
+#include "compress.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace interval_mist::compress {
+
+TEST(CompressTest, Empty) {
+  auto c = compress<int64_t>({});
+  ASSERT_TRUE(c.has_value());
+  EXPECT_TRUE(c->intervals.empty());
+  EXPECT_TRUE(c->values.empty());
+}
+
+TEST(CompressTest, Integers) {
+  // Large timestamps either side of zero, with a repeat and a shared endpoint
+  std::vector<Raw<int64_t>> is = {{1'700'000'000'000, 1'700'000'000'500},
+                                   {-40, 3},
+                                   {3, 1'700'000'000'000},
+                                   {-40, 3}};
+  auto c = compress<int64_t>(is);
+  ASSERT_TRUE(c.has_value());
+  EXPECT_EQ(std::vector<int64_t>({-40, 3, 1'700'000'000'000,
+                                  1'700'000'000'500}),
+            c->values);
+  EXPECT_EQ(std::vector<Interval>(
+                {Interval(0, 1), Interval(1, 2), Interval(2, 3)}),
+            c->intervals);
+  EXPECT_EQ(is[0], c->original(c->intervals[2]));
+}
+
+TEST(CompressTest, Unsigned) {
+  uint64_t top = std::numeric_limits<uint64_t>::max();
+  std::vector<Raw<uint64_t>> is = {{top - 1, top}, {0, top}};
+  auto c = compress<uint64_t>(is);
+  ASSERT_TRUE(c.has_value());
+  EXPECT_EQ(std::vector<Interval>({Interval(0, 2), Interval(1, 2)}),
+            c->intervals);
+}
+
+TEST(CompressTest, FloatingPoint) {
+  std::vector<Raw<double>> is = {{-0.0, 1.5}, {-2.25, 0.0}, {1e300, 1e301}};
+  auto c = compress<double>(is);
+  ASSERT_TRUE(c.has_value());
+  EXPECT_EQ(std::vector<double>({-2.25, 0.0, 1.5, 1e300, 1e301}), c->values);
+  EXPECT_EQ(std::vector<Interval>(
+                {Interval(0, 1), Interval(1, 2), Interval(3, 4)}),
+            c->intervals);
+}
+
+TEST(CompressTest, Rejects) {
+  EXPECT_FALSE(compress<int64_t>({{{3, 2}}}).has_value());
+  EXPECT_FALSE(compress<double>({{{0, NAN}}}).has_value());
+  EXPECT_FALSE(compress<double>({{{1, -1}}}).has_value());
+}
+
+TEST(CompressTest, MatchesComparisonSort) {
+  std::mt19937_64 gen(0);
+  for (size_t n : {1, 10, 100, 1000}) {
+    // Endpoints from a small range, to get repeats, spread over 64 bits
+    std::uniform_int_distribution<int64_t> coord(-int64_t(n), n);
+    std::vector<Raw<int64_t>> is;
+    for (size_t i = 0; i < n; ++i) {
+      int64_t a = coord(gen) << 40, b = coord(gen) << 40;
+      is.push_back({std::min(a, b), std::max(a, b)});
+    }
+    auto c = compress<int64_t>(is);
+    ASSERT_TRUE(c.has_value());
+    EXPECT_TRUE(std::is_sorted(c->values.begin(), c->values.end()));
+    EXPECT_TRUE(std::adjacent_find(c->intervals.begin(), c->intervals.end(),
+                                   std::greater_equal()) ==
+                c->intervals.end());
+
+    // The same intervals, in canonical order of the originals
+    std::vector<std::pair<int64_t, int64_t>> expected, actual;
+    for (auto [lower, upper] : is) {
+      expected.emplace_back(upper, lower);
+    }
+    std::sort(expected.begin(), expected.end());
+    expected.erase(std::unique(expected.begin(), expected.end()),
+                   expected.end());
+    for (Interval i : c->intervals) {
+      actual.emplace_back(c->original(i).upper, c->original(i).lower);
+    }
+    EXPECT_EQ(expected, actual);
+  }
+}
+
+} // namespace interval_mist::compress
@@ -0,0 +1,193 @@
+#include "cut_points.hpp"
+
+#include "forest.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <numeric>
+#include <utility>
+
+namespace interval_mist::cut_points {
+
+using Coord = Interval::Coord;
+using Id = SpanningTree::Id;
+
+std::vector<Cut> cuts(std::span<const Interval> is) {
+  if (is.empty())
+    return {};
+
+  // Coverage changes at each left endpoint and just after each right one.
+  // Alongside the count, keep the sum of the indices covering, which is the
+  // index of the only one wherever the count is 1.
+  struct Event {
+    uint64_t coord;
+    int64_t delta;
+  };
+  std::vector<Event> events;
+  events.reserve(2 * is.size());
+  Coord max_lower = 0;
+  for (size_t i = 0; i < is.size(); ++i) {
+    events.push_back({is[i].lower, int64_t(i) + 1});
+    events.push_back({uint64_t(is[i].upper) + 1, -(int64_t(i) + 1)});
+    max_lower = std::max(max_lower, is[i].lower);
+  }
+  std::sort(events.begin(), events.end(),
+            [](const Event &a, const Event &b) { return a.coord < b.coord; });
+
+  // Something lies wholly to the left of p once p passes the first right
+  // endpoint, and wholly to the right while p is before the last left one
+  uint64_t first = uint64_t(is[0].upper) + 1, last = max_lower;
+
+  std::vector<Cut> result;
+  size_t count = 0;
+  int64_t sum = 0;
+  for (size_t e = 0; e < events.size();) {
+    uint64_t coord = events[e].coord;
+    for (; e < events.size() && events[e].coord == coord; ++e) {
+      count += events[e].delta > 0 ? 1 : -1;
+      sum += events[e].delta;
+    }
+    if (count != 1 || e == events.size())
+      continue;
+
+    // Points [coord, next) are covered by one interval alone
+    uint64_t lo = std::max(coord, first), hi = std::min(events[e].coord, last);
+    if (lo < hi)
+      result.push_back({Coord(lo), size_t(sum - 1)});
+  }
+  return result;
+}
+
+std::vector<Block> blocks(std::span<const Interval> is,
+                          std::span<const Cut> cuts) {
+  std::vector<bool> is_cut(is.size());
+  for (const Cut &cut : cuts) {
+    is_cut[cut.interval] = true;
+  }
+
+  // Every other interval lies wholly between two consecutive cuts, and in
+  // canonical order they come block by block
+  std::vector<std::vector<size_t>> members(cuts.size() + 1);
+  size_t passed = 0;
+  for (size_t i = 0; i < is.size(); ++i) {
+    if (is_cut[i])
+      continue;
+    while (passed < cuts.size() && cuts[passed].point < is[i].upper) {
+      ++passed;
+    }
+    members[passed].push_back(i);
+  }
+
+  std::vector<Block> result;
+  for (size_t b = 0; b < members.size(); ++b) {
+    std::vector<std::pair<Interval, size_t>> vs;
+    for (size_t i : members[b]) {
+      vs.emplace_back(is[i], i);
+    }
+    // Cuts at each end, each with its pendant
+    std::vector<const Cut *> ends;
+    if (b > 0)
+      ends.push_back(&cuts[b - 1]);
+    if (b < cuts.size())
+      ends.push_back(&cuts[b]);
+    for (const Cut *cut : ends) {
+      vs.emplace_back(Interval(cut->point, cut->point), padding);
+    }
+    if (ends.size() == 2 && ends[0]->interval == ends[1]->interval) {
+      if (vs.size() == 2)
+        continue;
+      ends.pop_back();
+    }
+    for (const Cut *cut : ends) {
+      vs.emplace_back(is[cut->interval], cut->interval);
+    }
+
+    std::sort(vs.begin(), vs.end());
+    Block &block = result.emplace_back();
+    for (auto [v, id] : vs) {
+      block.intervals.push_back(v);
+      block.ids.push_back(id);
+    }
+  }
+  return result;
+}
+
+std::optional<SpanningTree> solve(std::span<const Interval> is,
+                                  const solvers::registry::Entry &entry,
+                                  thread_pool::ThreadPool &pool) {
+  if (forest::components(is).size() != 1)
+    return {};
+  if (is.size() == 1)
+    return SpanningTree({is[0]});
+
+  auto cs = cuts(is);
+  auto bs = blocks(is, cs);
+
+  std::vector<size_t> order(bs.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&bs](size_t a, size_t b) {
+    return bs[a].intervals.size() > bs[b].intervals.size();
+  });
+
+  std::vector<std::optional<SpanningTree>> trees(bs.size());
+  std::atomic<bool> failed = false;
+  pool.parallel_for(order.size(), [&](size_t k) {
+    // No point solving the rest once one block has no tree
+    if (failed.load())
+      return;
+    const Block &block = bs[order[k]];
+    auto &tree = trees[order[k]];
+    if (solvers::registry::fits(entry, block.intervals))
+      tree = solvers::registry::run(entry, block.intervals);
+    if (!tree)
+      failed = true;
+  });
+  if (failed.load())
+    return {};
+
+  // Pendants hang off their cut intervals, so dropping them leaves a tree of
+  // the block's own intervals, and the blocks' trees meet only at the cuts
+  std::vector<std::vector<Id>> adj(is.size());
+  for (size_t b = 0; b < bs.size(); ++b) {
+    const auto &ids = bs[b].ids;
+    const SpanningTree &tree = trees[b].value();
+    for (Id u = 0; u < tree.num_verts(); ++u) {
+      Id p = tree.parent(u);
+      if (p == SpanningTree::no_parent || ids[u] == padding ||
+          ids[p] == padding)
+        continue;
+      adj[ids[u]].push_back(ids[p]);
+      adj[ids[p]].push_back(ids[u]);
+    }
+  }
+
+  // Add the edges outwards from the first interval, so each joins a new
+  // vertex to the tree without rerooting
+  SpanningTree result(std::vector<Interval>(is.begin(), is.end()));
+  std::vector<bool> seen(is.size());
+  std::vector<Id> stack = {0};
+  seen[0] = true;
+  while (!stack.empty()) {
+    Id u = stack.back();
+    stack.pop_back();
+    for (Id v : adj[u]) {
+      if (seen[v])
+        continue;
+      seen[v] = true;
+      result.add_edge(u, v);
+      stack.push_back(v);
+    }
+  }
+  assert(result.is_valid());
+  return result;
+}
+
+std::optional<SpanningTree> solve(std::span<const Interval> is,
+                                  const solvers::registry::Entry &entry) {
+  thread_pool::ThreadPool pool;
+  return solve(is, entry, pool);
+}
+
+} // namespace interval_mist::cut_points
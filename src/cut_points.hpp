@@ -0,0 +1,67 @@
+#pragma once
+
+#include "interval.hpp"
+#include "solvers/registry.hpp"
+#include "spanning_tree.hpp"
+#include "thread_pool.hpp"
+
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace interval_mist::cut_points {
+
+using Interval = interval_mist::interval::Interval;
+using SpanningTree = interval_mist::graph::SpanningTree;
+
+// Point covered by is[interval] alone, with other intervals wholly to either
+// side of it. Edges can only cross the point through is[interval], which is
+// therefore a cut vertex of the interval graph.
+struct Cut {
+  Interval::Coord point;
+  size_t interval;
+
+  friend bool operator==(const Cut &, const Cut &) = default;
+};
+
+// Cuts of is, which must be distinct, in canonical order and connected, by a
+// sweep over endpoints in O(n log n). There is one cut per run of points
+// covered by a single interval, in order of point.
+std::vector<Cut> cuts(std::span<const Interval> is);
+
+static constexpr size_t padding = std::numeric_limits<size_t>::max();
+
+// Intervals between consecutive cuts, together with the cut intervals at each
+// end. Each cut interval also gets a pendant, a point interval at its cut
+// meeting nothing else in the block, so that any spanning tree of the block
+// has the cut interval internal and the pendant as a leaf. Minimising the
+// leaves of the padded block then minimises the leaves of the whole tree that
+// fall in the block, and the blocks can be solved independently.
+struct Block {
+  // In canonical order
+  std::vector<Interval> intervals;
+  // Index into is of each interval, or padding for a pendant
+  std::vector<size_t> ids;
+};
+
+// Blocks of is between its cuts, in order, leaving out any with nothing
+// between two cuts of the same interval
+std::vector<Block> blocks(std::span<const Interval> is,
+                          std::span<const Cut> cuts);
+
+// Solves is (distinct and in canonical order) by splitting it at its cuts,
+// solving the blocks with entry across pool, largest first, and joining their
+// trees at the cut intervals. If entry finds trees with fewest leaves, so does
+// this. Returns nothing if is is disconnected, or if entry finds no tree for
+// some block or cannot take it.
+std::optional<SpanningTree> solve(std::span<const Interval> is,
+                                  const solvers::registry::Entry &entry,
+                                  thread_pool::ThreadPool &pool);
+
+// As above, with a thread per core
+std::optional<SpanningTree> solve(std::span<const Interval> is,
+                                  const solvers::registry::Entry &entry);
+
+} // namespace interval_mist::cut_points
@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+
+#include "cut_points.hpp"
+
+#include <vector>
+
+namespace interval_mist::cut_points {
+
+namespace registry = solvers::registry;
+
+// Random connected groups of num intervals, each joined to the next by an
+// interval meeting only the last endpoint of one and the first of the other
+static std::vector<Interval> chain(size_t seed, size_t num_groups,
+                                   size_t num) {
+  std::vector<Interval> is;
+  for (size_t k = 0; k < num_groups; ++k) {
+    Interval::Coord offset = k * (2 * num + 1);
+    for (Interval i :
+         interval::random_connected_intervals(seed * num_groups + k, num)) {
+      is.push_back(Interval(i.lower + offset, i.upper + offset));
+    }
+    if (k + 1 < num_groups)
+      is.push_back(Interval(offset + 2 * num - 1, offset + 2 * num + 1));
+  }
+  std::sort(is.begin(), is.end());
+  return is;
+}
+
+TEST(CutPointsTest, Cuts) {
+  // In canonical order: a, c, b, d, e. Only b covers 5, with a and c to its
+  // left and d and e to its right. Points covered by a or e alone have
+  // nothing beyond them.
+  Interval a(0, 2), b(2, 6), c(3, 4), d(6, 8), e(7, 9);
+  std::vector<Interval> is = {a, c, b, d, e};
+  auto cs = cuts(is);
+  EXPECT_EQ(std::vector<Cut>({{5, 2}}), cs);
+
+  auto bs = blocks(is, cs);
+  ASSERT_EQ(2, bs.size());
+  EXPECT_EQ(std::vector<Interval>({a, c, Interval(5, 5), b}),
+            bs[0].intervals);
+  EXPECT_EQ(std::vector<size_t>({0, 1, padding, 2}), bs[0].ids);
+  EXPECT_EQ(std::vector<Interval>({Interval(5, 5), b, d, e}),
+            bs[1].intervals);
+  EXPECT_EQ(std::vector<size_t>({padding, 2, 3, 4}), bs[1].ids);
+}
+
+TEST(CutPointsTest, NoCuts) {
+  std::vector<Interval> is = {Interval(0, 3), Interval(1, 4), Interval(2, 5)};
+  EXPECT_TRUE(cuts(is).empty());
+  ASSERT_EQ(1, blocks(is, {}).size());
+  EXPECT_EQ(is, blocks(is, {})[0].intervals);
+}
+
+TEST(CutPointsTest, BlocksOfOneCutInterval) {
+  // b alone covers 3 and 7, with c between and a and d either side
+  Interval a(0, 2), b(2, 10), c(5, 6), d(10, 12);
+  std::vector<Interval> is = {a, c, b, d};
+  auto cs = cuts(is);
+  ASSERT_EQ(2, cs.size());
+  auto bs = blocks(is, cs);
+  ASSERT_EQ(3, bs.size());
+  EXPECT_EQ(std::vector<Interval>({Interval(3, 3), c, Interval(7, 7), b}),
+            bs[1].intervals);
+}
+
+TEST(CutPointsTest, SameLeavesAsWhole) {
+  const registry::Entry &dp = *registry::find("dp");
+  thread_pool::ThreadPool pool(2);
+  size_t num_cuts = 0;
+  for (size_t seed = 0; seed < 100; ++seed) {
+    auto is = chain(seed, 3, 3);
+    num_cuts += cuts(is).size();
+    auto whole = registry::run(dp, is);
+    auto split = solve(is, dp, pool);
+    ASSERT_TRUE(whole.has_value());
+    ASSERT_TRUE(split.has_value());
+    EXPECT_TRUE(split->is_spanning_tree_of(std::span<const Interval>(is)));
+    EXPECT_EQ(whole->num_leaves(), split->num_leaves()) << "seed " << seed;
+  }
+  EXPECT_GE(num_cuts, 200);
+}
+
+TEST(CutPointsTest, ChainBeyondSolverLimits) {
+  auto is = chain(0, 30, 8);
+  const registry::Entry &dp = *registry::find("dp");
+  EXPECT_FALSE(registry::fits(dp, is));
+
+  auto split = solve(is, dp);
+  ASSERT_TRUE(split.has_value());
+  EXPECT_TRUE(split->is_spanning_tree_of(std::span<const Interval>(is)));
+  auto greedy = registry::run(*registry::find("greedy_sorted"), is);
+  EXPECT_EQ(greedy->num_leaves(), split->num_leaves());
+}
+
+TEST(CutPointsTest, Disconnected) {
+  std::vector<Interval> is = {Interval(0, 1), Interval(2, 3)};
+  EXPECT_FALSE(solve(is, *registry::find("greedy_sorted")).has_value());
+}
+
+} // namespace interval_mist::cut_points
@@ -0,0 +1,209 @@
+#include "dynamic_mist.hpp"
+
+#include "solvers/greedy.hpp"
+#include "spanning_tree.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <span>
+#include <utility>
+
+namespace interval_mist::dynamic_mist {
+
+using Coord = Interval::Coord;
+using Edge = DynamicMist::Edge;
+
+bool DynamicMist::insert(Interval i) {
+  if (!live.insert(i).second)
+    return false;
+  repair(2 * Key(i.lower), 2 * Key(i.upper));
+  return true;
+}
+
+bool DynamicMist::erase(Interval i) {
+  if (!live.erase(i))
+    return false;
+  repair(2 * Key(i.lower), 2 * Key(i.upper));
+  return true;
+}
+
+bool DynamicMist::contains(Interval i) const { return live.count(i); }
+
+size_t DynamicMist::size() const { return live.size(); }
+
+const std::set<Interval> &DynamicMist::intervals() const { return live; }
+
+size_t DynamicMist::num_leaves() const { return leaves; }
+
+size_t DynamicMist::num_components() const {
+  return live.empty() ? 0 : num_gaps + 1;
+}
+
+std::vector<Edge> DynamicMist::edges() const {
+  std::vector<Edge> result;
+  for (const auto &[key, block] : blocks) {
+    result.insert(result.end(), block.edges.begin(), block.edges.end());
+  }
+  return result;
+}
+
+Graph DynamicMist::to_graph() const {
+  auto es = edges();
+  return Graph(live, std::set<Edge>(es.begin(), es.end()));
+}
+
+void DynamicMist::repair(Key lo, Key hi) {
+  // Only separators within [lo, hi] change coverage. The nearest either side
+  // can still appear or vanish as what lies beyond them changes, but the next
+  // ones out are held in place by the blocks between.
+  Key first = before, last = after;
+  auto below = separators.lower_bound(lo);
+  if (below != separators.begin() && std::prev(below) != separators.begin())
+    first = std::prev(below, 2)->first;
+  auto above = separators.upper_bound(hi);
+  if (above != separators.end() && std::next(above) != separators.end())
+    last = std::next(above)->first;
+  std::optional<Interval> first_cut, last_cut;
+  if (first != before)
+    first_cut = separators.at(first);
+  if (last != after)
+    last_cut = separators.at(last);
+
+  // Everything meeting keys (first, last). Past last, only its own cut
+  // interval starts before it.
+  std::vector<Interval> is;
+  auto it = first == before ? live.begin()
+                            : live.lower_bound(Interval(0, first / 2 + 1));
+  for (; it != live.end() && (last == after || 2 * Key(it->upper) < last);
+       ++it) {
+    is.push_back(*it);
+  }
+  if (last_cut)
+    is.push_back(*last_cut);
+
+  // Sweep coverage as cut_points does, at twice the scale so that starts and
+  // ends never share a key. A run covered by one interval is a cut if
+  // something in its component ended before it and something starts after.
+  struct Event {
+    Key key;
+    int64_t delta;
+  };
+  std::vector<Event> events;
+  events.reserve(2 * is.size());
+  for (size_t i = 0; i < is.size(); ++i) {
+    events.push_back({2 * Key(is[i].lower), int64_t(i) + 1});
+    events.push_back({2 * Key(is[i].upper) + 1, -(int64_t(i) + 1)});
+  }
+  std::sort(events.begin(), events.end(),
+            [](const Event &a, const Event &b) { return a.key < b.key; });
+
+  std::vector<std::pair<Key, std::optional<size_t>>> found;
+  size_t count = 0, ended = 0;
+  int64_t sum = 0;
+  for (size_t e = 0; e < events.size();) {
+    Key key = events[e].key;
+    for (; e < events.size() && events[e].key == key; ++e) {
+      if (events[e].delta > 0) {
+        ++count;
+      } else {
+        --count;
+        ++ended;
+      }
+      sum += events[e].delta;
+    }
+    if (count == 0)
+      ended = 0;
+    if (key <= first) {
+      // Only the cut interval of first spans it, and something before it
+      // ended
+      ended = first_cut ? 1 : 0;
+      continue;
+    }
+    if (key >= last || e == events.size())
+      continue;
+    if (count == 0)
+      found.emplace_back(key, std::nullopt);
+    else if (count == 1 && ended > 0 && events[e].delta > 0)
+      found.emplace_back(key, size_t(sum - 1));
+  }
+
+  // Replace what was there
+  for (auto s = separators.upper_bound(first);
+       s != separators.end() && s->first < last;) {
+    num_gaps -= !s->second;
+    s = separators.erase(s);
+  }
+  for (auto b = blocks.upper_bound(first);
+       b != blocks.end() && b->first <= last;) {
+    leaves -= b->second.num_leaves;
+    b = blocks.erase(b);
+  }
+
+  std::vector<bool> is_cut(is.size());
+  std::vector<std::pair<Key, std::optional<Interval>>> ends = {
+      {first, first_cut}};
+  for (auto [key, i] : found) {
+    ends.emplace_back(key, i ? std::optional(is[*i]) : std::nullopt);
+    separators.emplace(key, ends.back().second);
+    if (i)
+      is_cut[*i] = true;
+    else
+      ++num_gaps;
+  }
+  ends.emplace_back(last, last_cut);
+  for (auto cut : {first_cut, last_cut}) {
+    if (cut)
+      is_cut[std::lower_bound(is.begin(), is.end(), *cut) - is.begin()] = true;
+  }
+
+  // Blocks between consecutive ends, each padded as in cut_points. A pendant
+  // at key k goes at the point just past it, on the side of the block.
+  std::vector<std::vector<Interval>> members(ends.size() - 1);
+  size_t passed = 0;
+  for (size_t i = 0; i < is.size(); ++i) {
+    if (is_cut[i])
+      continue;
+    while (passed < found.size() && found[passed].first < 2 * Key(is[i].upper))
+      ++passed;
+    members[passed].push_back(is[i]);
+  }
+  for (size_t b = 0; b < members.size(); ++b) {
+    auto [left, left_cut] = ends[b];
+    auto [right, right_cut] = ends[b + 1];
+    std::vector<Interval> vs = std::move(members[b]);
+    std::vector<Interval> pendants;
+    if (left_cut) {
+      pendants.push_back(Interval(Coord(left / 2), Coord(left / 2)));
+      vs.push_back(*left_cut);
+    }
+    if (right_cut) {
+      pendants.push_back(
+          Interval(Coord((right + 1) / 2), Coord((right + 1) / 2)));
+      if (left_cut != right_cut)
+        vs.push_back(*right_cut);
+    }
+    if (vs.empty())
+      continue;
+    vs.insert(vs.end(), pendants.begin(), pendants.end());
+    std::sort(vs.begin(), vs.end());
+
+    auto tree = solvers::greedy::interval_mist_greedy_sorted(vs);
+    assert(tree.has_value());
+    Block &block = blocks[right];
+    block.num_leaves = tree->num_leaves() - pendants.size();
+    auto is_pendant = [&pendants](Interval v) {
+      return std::find(pendants.begin(), pendants.end(), v) != pendants.end();
+    };
+    for (graph::SpanningTree::Id u = 0; u < tree->num_verts(); ++u) {
+      auto p = tree->parent(u);
+      if (p == graph::SpanningTree::no_parent ||
+          is_pendant(tree->vertex(u)) || is_pendant(tree->vertex(p)))
+        continue;
+      block.edges.push_back(Edge(tree->vertex(u), tree->vertex(p)));
+    }
+    leaves += block.num_leaves;
+  }
+}
+
+} // namespace interval_mist::dynamic_mist
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "graph.hpp"
+#include "interval.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <optional>
+#include <set>
+#include <vector>
+
+namespace interval_mist::dynamic_mist {
+
+using Interval = interval_mist::interval::Interval;
+using Graph = interval_mist::graph::Graph;
+
+// Spanning forest with fewest leaves of a live set of intervals, one tree per
+// component, kept up to date as intervals come and go.
+//
+// The line is split at separators: points (or the gaps between neighbouring
+// points) that no interval spans, between components, or that one interval
+// alone spans, with intervals of its component wholly to either side, making
+// it a cut vertex. The blocks between consecutive separators are solved apart
+// with the greedy, as cut_points does, so an update only re-solves the blocks
+// near the interval that changed. That is O(k log k) for k intervals in those
+// blocks, plus O(log n) to find them, and all of the set only when it has no
+// separators at all.
+struct DynamicMist {
+  using Edge = Graph::Edge;
+
+  // Adds i, returning false if it is already present
+  bool insert(Interval i);
+
+  // Removes i, returning false if it is not present
+  bool erase(Interval i);
+
+  bool contains(Interval i) const;
+
+  size_t size() const;
+
+  const std::set<Interval> &intervals() const;
+
+  // Of the whole forest, in O(1)
+  size_t num_leaves() const;
+
+  size_t num_components() const;
+
+  // Edges of the forest, block by block from left to right
+  std::vector<Edge> edges() const;
+
+  Graph to_graph() const;
+
+private:
+  // Positions on the line at twice the scale, so that key 2p is the point p
+  // and key 2p + 1 lies between p and p + 1. Keys past either end stand in
+  // for the lack of a separator there.
+  using Key = int64_t;
+  static constexpr Key before = -1;
+  static constexpr Key after = std::numeric_limits<Key>::max();
+
+  struct Block {
+    std::vector<Edge> edges;
+    size_t num_leaves = 0;
+  };
+
+  // Re-solves everything strictly between the second separators either side
+  // of keys [lo, hi], which covers every separator and block an update there
+  // can change
+  void repair(Key lo, Key hi);
+
+  std::set<Interval> live;
+  // By key of the first point of each run, with the interval spanning it, or
+  // nothing for a gap between components
+  std::map<Key, std::optional<Interval>> separators;
+  // By key of the separator ending each, or after for the last
+  std::map<Key, Block> blocks;
+  size_t num_gaps = 0;
+  size_t leaves = 0;
+};
+
+} // namespace interval_mist::dynamic_mist
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+
+#include "dynamic_mist.hpp"
+
+#include "forest.hpp"
+
+#include <map>
+#include <random>
+#include <vector>
+
+namespace interval_mist::dynamic_mist {
+
+namespace registry = solvers::registry;
+
+// Checks m against its intervals solved from scratch with entry
+static void check(const DynamicMist &m, const registry::Entry &entry) {
+  std::vector<Interval> is(m.intervals().begin(), m.intervals().end());
+  auto whole = forest::solve(is, entry);
+  ASSERT_TRUE(whole.complete());
+  EXPECT_EQ(whole.components.size(), m.num_components());
+  EXPECT_EQ(whole.num_leaves(), m.num_leaves());
+
+  // A spanning forest: acyclic edges of the interval graph, one fewer per
+  // component than there are intervals, with a leaf wherever a vertex has one
+  Graph g = m.to_graph();
+  EXPECT_EQ(is.size() - m.num_components(), g.edges.size());
+  std::map<Interval, Interval> root;
+  auto find = [&root](Interval v) {
+    while (root.count(v))
+      v = root.at(v);
+    return v;
+  };
+  std::map<Interval, size_t> degree;
+  for (Graph::Edge e : g.edges) {
+    EXPECT_TRUE(e.src.intersects(e.dst));
+    Interval u = find(e.src), v = find(e.dst);
+    EXPECT_NE(u, v);
+    if (u != v)
+      root.emplace(u, v);
+    ++degree[e.src];
+    ++degree[e.dst];
+  }
+  size_t leaves = 0;
+  for (auto [v, d] : degree) {
+    leaves += d == 1;
+  }
+  EXPECT_EQ(m.num_leaves(), leaves);
+}
+
+TEST(DynamicMistTest, Empty) {
+  DynamicMist m;
+  EXPECT_EQ(0, m.size());
+  EXPECT_EQ(0, m.num_leaves());
+  EXPECT_EQ(0, m.num_components());
+  EXPECT_TRUE(m.edges().empty());
+}
+
+TEST(DynamicMistTest, InsertAndErase) {
+  DynamicMist m;
+  Interval a(0, 2), b(2, 6), c(3, 4), d(6, 8), e(7, 9);
+  EXPECT_TRUE(m.insert(a));
+  EXPECT_FALSE(m.insert(a));
+  EXPECT_EQ(0, m.num_leaves());
+  EXPECT_TRUE(m.insert(d));
+  EXPECT_EQ(2, m.num_components());
+  // b joins a and d, and c hangs off it
+  for (Interval i : {b, c, e}) {
+    EXPECT_TRUE(m.insert(i));
+  }
+  EXPECT_EQ(1, m.num_components());
+  EXPECT_EQ(3, m.num_leaves());
+  EXPECT_TRUE(m.contains(c));
+
+  EXPECT_TRUE(m.erase(b));
+  EXPECT_FALSE(m.erase(b));
+  EXPECT_FALSE(m.contains(b));
+  EXPECT_EQ(3, m.num_components());
+  EXPECT_EQ(2, m.num_leaves());
+  for (Interval i : {a, c, d, e}) {
+    EXPECT_TRUE(m.erase(i));
+  }
+  EXPECT_EQ(0, m.size());
+  EXPECT_EQ(0, m.num_leaves());
+  EXPECT_TRUE(m.edges().empty());
+}
+
+TEST(DynamicMistTest, CutBetweenPoints) {
+  // Only b spans the gap between 2 and 3, though every point has two
+  DynamicMist m;
+  for (Interval i : {Interval(0, 2), Interval(2, 3), Interval(3, 5)}) {
+    m.insert(i);
+  }
+  EXPECT_EQ(2, m.num_leaves());
+  check(m, *registry::find("dp"));
+}
+
+TEST(DynamicMistTest, RandomUpdatesMatchFromScratch) {
+  const registry::Entry &dp = *registry::find("dp");
+  for (size_t seed = 0; seed < 40; ++seed) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<Interval::Coord> coord(0, 20), len(0, 3);
+    DynamicMist m;
+    for (size_t step = 0; step < 30; ++step) {
+      Interval::Coord lower = coord(gen);
+      Interval i(lower, lower + len(gen));
+      // Grow to around ten, then churn
+      if (m.size() < 10 || gen() % 2)
+        m.insert(i);
+      else
+        m.erase(*std::next(m.intervals().begin(), gen() % m.size()));
+      check(m, dp);
+      if (testing::Test::HasFailure())
+        FAIL() << "seed " << seed << " step " << step;
+    }
+  }
+}
+
+TEST(DynamicMistTest, LongChurn) {
+  // Sparse enough to split often, checked against the greedy on everything
+  const registry::Entry &greedy = *registry::find("greedy_sorted");
+  std::mt19937 gen(7);
+  std::uniform_int_distribution<Interval::Coord> coord(0, 4000), len(0, 12);
+  DynamicMist m;
+  for (size_t step = 0; step < 3000; ++step) {
+    Interval::Coord lower = coord(gen);
+    Interval i(lower, lower + len(gen));
+    if (m.size() < 500 || gen() % 2)
+      m.insert(i);
+    else
+      m.erase(*std::next(m.intervals().begin(), gen() % m.size()));
+    if (step % 250 == 0)
+      check(m, greedy);
+  }
+  check(m, greedy);
+}
+
+} // namespace interval_mist::dynamic_mist
@@ -0,0 +1,100 @@
+#include "forest.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <limits>
+#include <numeric>
+
+namespace interval_mist::forest {
+
+using Coord = Interval::Coord;
+
+std::vector<Component> components(std::span<const Interval> is) {
+  // Smallest left endpoint of is[i], ..., is[n - 1]
+  std::vector<Coord> min_lower(is.size() + 1,
+                               std::numeric_limits<Coord>::max());
+  for (size_t i = is.size(); i-- > 0;) {
+    min_lower[i] = std::min(min_lower[i + 1], is[i].lower);
+  }
+
+  // Intervals are closed, so one starting exactly where another ends meets it
+  std::vector<Component> result;
+  size_t begin = 0;
+  for (size_t i = 0; i < is.size(); ++i) {
+    assert(i == 0 || is[i - 1] < is[i]);
+    if (i + 1 == is.size() || min_lower[i + 1] > is[i].upper) {
+      result.push_back({begin, i + 1});
+      begin = i + 1;
+    }
+  }
+  return result;
+}
+
+bool Forest::complete() const {
+  return std::all_of(components.begin(), components.end(),
+                     [](const ComponentResult &c) { return c.tree; });
+}
+
+size_t Forest::num_leaves() const {
+  size_t total = 0;
+  for (const ComponentResult &c : components) {
+    if (c.tree)
+      total += c.tree->num_leaves();
+  }
+  return total;
+}
+
+size_t Forest::num_internal() const {
+  size_t total = 0;
+  for (const ComponentResult &c : components) {
+    if (c.tree)
+      total += c.tree->num_internal();
+  }
+  return total;
+}
+
+Forest solve(std::span<const Interval> is,
+             const solvers::registry::Entry &entry,
+             thread_pool::ThreadPool &pool) {
+  Forest forest;
+  for (Component c : components(is)) {
+    forest.components.push_back({.component = c, .tree = {}});
+  }
+
+  // Start the largest components first, so that the last to finish are small
+  std::vector<size_t> order(forest.components.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&forest](size_t a, size_t b) {
+    return forest.components[a].component.size() >
+           forest.components[b].component.size();
+  });
+
+  pool.parallel_for(order.size(), [&](size_t k) {
+    ComponentResult &result = forest.components[order[k]];
+    auto part = is.subspan(result.component.begin, result.component.size());
+    // An isolated interval is its own tree, whatever the solver makes of it
+    if (part.size() == 1) {
+      result.tree.emplace(std::vector<Interval>{part[0]});
+      return;
+    }
+    if (!solvers::registry::fits(entry, part))
+      return;
+
+    auto start = std::chrono::steady_clock::now();
+    result.tree = solvers::registry::run(entry, part);
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    result.seconds = elapsed.count();
+  });
+
+  return forest;
+}
+
+Forest solve(std::span<const Interval> is,
+             const solvers::registry::Entry &entry) {
+  thread_pool::ThreadPool pool;
+  return solve(is, entry, pool);
+}
+
+} // namespace interval_mist::forest
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "interval.hpp"
+#include "solvers/registry.hpp"
+#include "spanning_tree.hpp"
+#include "thread_pool.hpp"
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace interval_mist::forest {
+
+using Interval = interval_mist::interval::Interval;
+using SpanningTree = interval_mist::graph::SpanningTree;
+
+// Positions [begin, end) of a run of intervals in canonical order
+struct Component {
+  size_t begin, end;
+
+  size_t size() const { return end - begin; }
+
+  friend bool operator==(const Component &, const Component &) = default;
+};
+
+// Connected components of the interval graph of is, which must be distinct
+// and in canonical order. Every interval of a component ends before any of a
+// later one starts, so components are runs of is, split wherever the smallest
+// left endpoint to come is past the right endpoint just seen. O(n) time.
+std::vector<Component> components(std::span<const Interval> is);
+
+struct ComponentResult {
+  Component component;
+  // Over the component's intervals alone, so ids are relative to its begin.
+  // Nothing if the solver found no tree or the component is beyond its limits.
+  std::optional<SpanningTree> tree;
+  double seconds = 0;
+};
+
+// Spanning forest with a tree per component, in canonical order
+struct Forest {
+  std::vector<ComponentResult> components;
+
+  // Whether every component has a tree
+  bool complete() const;
+
+  // Totals over the components with a tree
+  size_t num_leaves() const;
+
+  size_t num_internal() const;
+};
+
+// Splits is (distinct and in canonical order) into components and solves each
+// with entry, largest first, across pool. Each component is solved alone, so
+// solvers that fail on disconnected input find a tree for every part.
+Forest solve(std::span<const Interval> is,
+             const solvers::registry::Entry &entry,
+             thread_pool::ThreadPool &pool);
+
+// As above, with a thread per core
+Forest solve(std::span<const Interval> is,
+             const solvers::registry::Entry &entry);
+
+} // namespace interval_mist::forest
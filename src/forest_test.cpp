@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+
+#include "forest.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace interval_mist::forest {
+
+namespace registry = solvers::registry;
+
+// Random connected sets of the given sizes, each shifted past the last, in
+// canonical order
+static std::vector<Interval> separated(const std::vector<size_t> &sizes) {
+  std::vector<Interval> is;
+  Interval::Coord offset = 0;
+  for (size_t k = 0; k < sizes.size(); ++k) {
+    for (Interval i : interval::random_connected_intervals(k, sizes[k])) {
+      is.push_back(Interval(i.lower + offset, i.upper + offset));
+    }
+    offset += 2 * sizes[k] + 1;
+  }
+  return is;
+}
+
+TEST(ForestTest, ComponentsEmpty) {
+  EXPECT_TRUE(components({}).empty());
+}
+
+TEST(ForestTest, ComponentsSplitAtGaps) {
+  // Touching intervals meet, and a long interval joins those it covers
+  std::vector<Interval> is = {Interval(0, 2), Interval(2, 3), Interval(5, 6),
+                              Interval(8, 9), Interval(7, 10),
+                              Interval(11, 12)};
+  EXPECT_EQ(std::vector<Component>({{0, 2}, {2, 3}, {3, 5}, {5, 6}}),
+            components(is));
+}
+
+TEST(ForestTest, ComponentsOfSeparatedSets) {
+  auto is = separated({5, 1, 12, 3});
+  EXPECT_EQ(std::vector<Component>({{0, 5}, {5, 6}, {6, 18}, {18, 21}}),
+            components(is));
+}
+
+TEST(ForestTest, SolvesEachComponent) {
+  auto is = separated({10, 1, 12, 7});
+  const registry::Entry &dp = *registry::find("dp");
+  EXPECT_FALSE(registry::run(dp, is).has_value());
+
+  thread_pool::ThreadPool pool(3);
+  Forest forest = solve(is, dp, pool);
+  ASSERT_EQ(4, forest.components.size());
+  EXPECT_TRUE(forest.complete());
+
+  size_t leaves = 0;
+  for (const ComponentResult &result : forest.components) {
+    auto part = std::span<const Interval>(is).subspan(
+        result.component.begin, result.component.size());
+    ASSERT_TRUE(result.tree.has_value());
+    EXPECT_TRUE(result.tree->is_spanning_tree_of(part));
+    if (part.size() > 1) {
+      EXPECT_EQ(registry::run(dp, part)->num_leaves(),
+                result.tree->num_leaves());
+    }
+    leaves += result.tree->num_leaves();
+  }
+  EXPECT_EQ(leaves, forest.num_leaves());
+  EXPECT_EQ(0, forest.components[1].tree->num_leaves());
+}
+
+TEST(ForestTest, SkipsComponentsBeyondLimits) {
+  auto is = separated({6, 200, 4});
+  Forest forest = solve(is, *registry::find("dp"));
+  ASSERT_EQ(3, forest.components.size());
+  EXPECT_FALSE(forest.complete());
+  EXPECT_TRUE(forest.components[0].tree.has_value());
+  EXPECT_FALSE(forest.components[1].tree.has_value());
+  EXPECT_TRUE(forest.components[2].tree.has_value());
+}
+
+TEST(ForestTest, IndependentOfThreads) {
+  std::vector<size_t> sizes(50);
+  for (size_t k = 0; k < sizes.size(); ++k) {
+    sizes[k] = 1 + k * 7 % 40;
+  }
+  auto is = separated(sizes);
+  const registry::Entry &greedy = *registry::find("greedy_sorted");
+
+  thread_pool::ThreadPool serial(1), parallel(4);
+  Forest lhs = solve(is, greedy, serial), rhs = solve(is, greedy, parallel);
+  ASSERT_EQ(sizes.size(), lhs.components.size());
+  ASSERT_EQ(lhs.components.size(), rhs.components.size());
+  for (size_t k = 0; k < lhs.components.size(); ++k) {
+    EXPECT_EQ(lhs.components[k].component, rhs.components[k].component);
+    EXPECT_EQ(lhs.components[k].tree->to_graph(),
+              rhs.components[k].tree->to_graph());
+  }
+  EXPECT_EQ(lhs.num_internal(), rhs.num_internal());
+}
+
+} // namespace interval_mist::forest
@@ -0,0 +1,170 @@
+#include "intervals.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <random>
+
+namespace interval_mist::generators::intervals {
+
+using Coord = Interval::Coord;
+
+static constexpr size_t max_coord = std::numeric_limits<Coord>::max();
+
+std::vector<Interval> uniform(size_t seed, size_t num) {
+  return interval::random_connected_intervals(seed, num);
+}
+
+std::vector<Interval> unit(size_t seed, size_t num, size_t length) {
+  assert(length >= 1);
+  assert(num * (length + 1) <= max_coord);
+  std::default_random_engine rng(seed);
+  // Gaps of at most length keep each interval touching the next
+  std::uniform_int_distribution<Coord> gap_dist(1, length);
+
+  std::vector<Interval> is;
+  is.reserve(num);
+  Coord lower = 0;
+  for (size_t i = 0; i < num; ++i) {
+    is.emplace_back(lower, lower + length);
+    lower += gap_dist(rng);
+  }
+  return is;
+}
+
+std::vector<Interval> nested(size_t seed, size_t num) {
+  assert(2 * num <= max_coord);
+  std::default_random_engine rng(seed);
+  std::uniform_int_distribution<uint8_t> open_dist(0, 2);
+
+  // Closing the most recently opened interval first keeps the family laminar,
+  // and the first stays open until the end to contain the rest
+  std::vector<Coord> open;
+  std::vector<Interval> is;
+  is.reserve(num);
+  size_t num_opened = 0;
+  for (Coord coord = 0; coord < 2 * num; ++coord) {
+    bool must_open = open.empty() || (open.size() == 1 && num_opened < num);
+    bool may_open = num_opened < num;
+    if (must_open || (may_open && open_dist(rng) != 0)) {
+      open.push_back(coord);
+      ++num_opened;
+    } else {
+      is.emplace_back(open.back(), coord);
+      open.pop_back();
+    }
+  }
+  return is;
+}
+
+std::vector<Interval> long_tailed(size_t seed, size_t num, double shape) {
+  assert(shape > 0);
+  assert(3 * num <= max_coord);
+  std::default_random_engine rng(seed);
+  std::uniform_real_distribution<double> unit_dist(0, 1);
+  std::uniform_int_distribution<Coord> gap_dist(1, 2);
+
+  // Left endpoints strictly increase, but never past the furthest right
+  // endpoint so far, which keeps the graph connected
+  std::vector<Interval> is;
+  is.reserve(num);
+  Coord lower = 0, reach = 0;
+  for (size_t i = 0; i < num; ++i) {
+    if (i > 0)
+      lower = std::min<Coord>(lower + gap_dist(rng), reach);
+    double length = std::ceil(std::pow(1 - unit_dist(rng), -1 / shape));
+    Coord upper = lower + static_cast<Coord>(std::min<double>(length, num));
+    is.emplace_back(lower, upper);
+    reach = std::max(reach, upper);
+  }
+
+  std::sort(is.begin(), is.end());
+  return is;
+}
+
+std::vector<Interval> bounded_clique(size_t seed, size_t num,
+                                     size_t max_clique) {
+  assert(max_clique >= 2);
+  assert(2 * num <= max_coord);
+  std::default_random_engine rng(seed);
+  std::uniform_int_distribution<uint8_t> bool_dist(0, 1);
+
+  // Open intervals in no particular order, as any one may close next
+  std::vector<Coord> open;
+  std::vector<Interval> is;
+  is.reserve(num);
+  Coord limit = 2 * num;
+  for (Coord coord = 0; coord < limit; ++coord) {
+    bool must_close =
+        (limit - coord) == open.size() || open.size() == max_clique;
+    bool must_open = open.size() <= 1 && !must_close;
+    bool do_open = must_open || (!must_close && bool_dist(rng));
+    if (do_open) {
+      open.push_back(coord);
+    } else {
+      size_t k =
+          std::uniform_int_distribution<size_t>(0, open.size() - 1)(rng);
+      is.emplace_back(open[k], coord);
+      open[k] = open.back();
+      open.pop_back();
+    }
+  }
+  return is;
+}
+
+std::vector<Interval> near_path(size_t seed, size_t num, double chord_rate) {
+  assert(2 * num + 8 <= max_coord);
+  std::default_random_engine rng(seed);
+  std::bernoulli_distribution chord_dist(chord_rate);
+  std::uniform_int_distribution<Coord> stretch_dist(2, 8);
+
+  // Interval i is [2i, 2i + 2], touching only its neighbours in the path
+  std::vector<Interval> is;
+  is.reserve(num);
+  for (Coord i = 0; i < num; ++i) {
+    Coord stretch = chord_dist(rng) ? stretch_dist(rng) : 0;
+    is.emplace_back(2 * i, 2 * i + 2 + stretch);
+  }
+
+  std::sort(is.begin(), is.end());
+  return is;
+}
+
+std::string name(Family family) {
+  switch (family) {
+  case Family::uniform:
+    return "uniform";
+  case Family::unit:
+    return "unit";
+  case Family::nested:
+    return "nested";
+  case Family::long_tailed:
+    return "long_tailed";
+  case Family::bounded_clique:
+    return "bounded_clique";
+  case Family::near_path:
+    return "near_path";
+  }
+  return "";
+}
+
+std::vector<Interval> generate(Family family, size_t seed, size_t num) {
+  switch (family) {
+  case Family::uniform:
+    return uniform(seed, num);
+  case Family::unit:
+    return unit(seed, num);
+  case Family::nested:
+    return nested(seed, num);
+  case Family::long_tailed:
+    return long_tailed(seed, num);
+  case Family::bounded_clique:
+    return bounded_clique(seed, num);
+  case Family::near_path:
+    return near_path(seed, num);
+  }
+  return {};
+}
+
+} // namespace interval_mist::generators::intervals
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "../interval.hpp"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace interval_mist::generators::intervals {
+
+using Interval = interval_mist::interval::Interval;
+
+// Each family returns num distinct intervals in canonical order whose interval
+// graph is connected, in O(n log n) time or better and O(n) memory, so they
+// can be used at 10^8 intervals. Coordinates are at most a small multiple of
+// num, and must fit in Interval::Coord.
+
+// As interval::random_connected_intervals: endpoints 0, ..., 2 * num - 1, each
+// step opening an interval or closing a random open one
+std::vector<Interval> uniform(size_t seed, size_t num);
+
+// Intervals all of the given length with strictly increasing left endpoints,
+// so a unit (hence proper) interval graph
+std::vector<Interval> unit(size_t seed, size_t num, size_t length = 8);
+
+// Laminar family, where any two intervals are disjoint or one contains the
+// other, under a single interval containing all the rest. Each step opens an
+// interval with probability 2 / 3, so nesting depth grows linearly.
+std::vector<Interval> nested(size_t seed, size_t num);
+
+// Lengths drawn from a Pareto distribution with the given shape (capped at
+// num), so mostly short intervals with a few spanning much of the range
+std::vector<Interval> long_tailed(size_t seed, size_t num, double shape = 1.5);
+
+// As uniform, but never with more than max_clique intervals open at once
+std::vector<Interval> bounded_clique(size_t seed, size_t num,
+                                     size_t max_clique = 8);
+
+// A path of intervals, each meeting the next, with one in every 1 / chord_rate
+// (on average) stretched to meet a few more
+std::vector<Interval> near_path(size_t seed, size_t num,
+                                double chord_rate = 0.125);
+
+enum class Family {
+  uniform,
+  unit,
+  nested,
+  long_tailed,
+  bounded_clique,
+  near_path,
+};
+
+constexpr Family families[] = {
+    Family::uniform,     Family::unit,           Family::nested,
+    Family::long_tailed, Family::bounded_clique, Family::near_path,
+};
+
+std::string name(Family family);
+
+// Generates from the family with its default parameters
+std::vector<Interval> generate(Family family, size_t seed, size_t num);
+
+} // namespace interval_mist::generators::intervals
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include "intervals.hpp"
+
+#include <algorithm>
+#include <set>
+
+namespace interval_mist::generators::intervals {
+
+// Whether sorted distinct intervals form a connected interval graph
+static bool is_connected(std::vector<Interval> is) {
+  std::sort(is.begin(), is.end(), [](const Interval &a, const Interval &b) {
+    return a.lower < b.lower;
+  });
+  for (size_t i = 1; i < is.size(); ++i) {
+    if (is[i].lower > is[i - 1].upper)
+      return false;
+    is[i].upper = std::max(is[i].upper, is[i - 1].upper);
+  }
+  return true;
+}
+
+// Most intervals containing a single point
+static size_t max_clique(const std::vector<Interval> &is) {
+  std::vector<std::pair<Interval::Coord, int>> events;
+  for (auto i : is) {
+    events.emplace_back(i.lower, -1);
+    events.emplace_back(i.upper, 1);
+  }
+  std::sort(events.begin(), events.end());
+  size_t curr = 0, best = 0;
+  for (auto [coord, change] : events) {
+    curr -= change;
+    best = std::max(best, curr);
+  }
+  return best;
+}
+
+TEST(IntervalsTest, Valid) {
+  for (auto family : families) {
+    for (size_t num : {0, 1, 2, 3, 10, 100, 1000}) {
+      for (size_t seed = 0; seed < 20; ++seed) {
+        auto is = generate(family, seed, num);
+        SCOPED_TRACE(name(family) + " " + std::to_string(num));
+        ASSERT_EQ(num, is.size());
+        EXPECT_TRUE(std::is_sorted(is.begin(), is.end()));
+        EXPECT_EQ(num, std::set<Interval>(is.begin(), is.end()).size());
+        EXPECT_TRUE(is_connected(is));
+      }
+    }
+  }
+}
+
+TEST(IntervalsTest, Deterministic) {
+  for (auto family : families) {
+    EXPECT_EQ(generate(family, 7, 500), generate(family, 7, 500));
+  }
+}
+
+TEST(IntervalsTest, UniformMatchesSet) {
+  for (size_t seed = 0; seed < 20; ++seed) {
+    auto is = uniform(seed, 50);
+    EXPECT_EQ(interval::random_connected_interval_set(seed, 50),
+              std::set<Interval>(is.begin(), is.end()));
+  }
+}
+
+TEST(IntervalsTest, Unit) {
+  for (auto i : unit(3, 1000, 5)) {
+    EXPECT_EQ(5, i.upper - i.lower);
+  }
+}
+
+TEST(IntervalsTest, Nested) {
+  auto is = nested(3, 200);
+  for (auto a : is) {
+    for (auto b : is) {
+      bool disjoint = a.upper < b.lower || b.upper < a.lower;
+      bool contains = a.lower <= b.lower && b.upper <= a.upper;
+      bool contained = b.lower <= a.lower && a.upper <= b.upper;
+      EXPECT_TRUE(disjoint || contains || contained);
+    }
+  }
+  // Nested intervals along a chain all meet, so deep nesting is a big clique
+  EXPECT_GT(max_clique(is), 20);
+}
+
+TEST(IntervalsTest, BoundedClique) {
+  for (size_t k : {2, 3, 8}) {
+    EXPECT_LE(max_clique(bounded_clique(3, 1000, k)), k);
+  }
+}
+
+TEST(IntervalsTest, NearPath) {
+  auto is = near_path(3, 1000, 0);
+  EXPECT_EQ(2, max_clique(is));
+}
+
+} // namespace interval_mist::generators::intervals
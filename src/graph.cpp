@@ -1,8 +1,11 @@
 #include "graph.hpp"
 
+#include "compact_graph.hpp"
+
+#include <algorithm>
 #include <cassert>
 #include <map>
-#include <stack>
+#include <utility>
 #include <vector>
 
 namespace interval_mist::graph {
@@ -28,9 +31,12 @@ Graph::Graph(std::set<Vertex> vs, std::set<Edge> es) : verts(vs), edges(es) {
 Graph Graph::interval_graph_from_set(std::set<Vertex> vs) {
   struct Event {
     Vertex vert;
+    // Position of vert in canonical order
+    size_t index;
     bool open;
 
-    Event(Vertex vert, bool open) : vert(vert), open(open) {}
+    Event(Vertex vert, size_t index, bool open)
+        : vert(vert), index(index), open(open) {}
 
     std::weak_ordering operator<=>(const Event &rhs) const {
       Vertex::Coord lc = open ? vert.lower : vert.upper;
@@ -42,26 +48,41 @@ Graph Graph::interval_graph_from_set(std::set<Vertex> vs) {
   };
 
   std::vector<Event> events;
+  size_t index = 0;
   for (auto vert : vs) {
-    events.emplace_back(vert, true);
-    events.emplace_back(vert, false);
+    events.emplace_back(vert, index, true);
+    events.emplace_back(vert, index, false);
+    ++index;
   }
   sort(events.begin(), events.end());
 
-  std::set<Edge> es;
-  std::set<Vertex> curr;
+  // Collect edges flat and sort once, so the set is built from sorted input
+  // in linear time rather than by an O(log m) insert per edge. Active
+  // intervals are unordered, each knowing its place among them, so a close
+  // swaps the last into its place in O(1).
+  std::vector<Edge> es;
+  std::vector<Vertex> curr;
+  std::vector<size_t> curr_index, place(vs.size());
   for (auto event : events) {
     if (event.open) {
       for (auto vert : curr) {
-        es.insert(Edge(event.vert, vert));
+        es.push_back(Edge(event.vert, vert));
       }
-      curr.insert(event.vert);
+      place[event.index] = curr.size();
+      curr.push_back(event.vert);
+      curr_index.push_back(event.index);
     } else {
-      curr.erase(event.vert);
+      size_t p = place[event.index];
+      curr[p] = curr.back();
+      curr_index[p] = curr_index.back();
+      place[curr_index[p]] = p;
+      curr.pop_back();
+      curr_index.pop_back();
     }
   }
+  std::sort(es.begin(), es.end());
 
-  return Graph(vs, es);
+  return Graph(std::move(vs), std::set<Edge>(es.begin(), es.end()));
 }
 
 Graph Graph::random_connected_interval_graph(size_t seed, size_t verts) {
@@ -79,36 +100,9 @@ void Graph::insert_edge(Edge e) {
 
 void Graph::insert_edge(Vertex u, Vertex v) { insert_edge(Edge(u, v)); }
 
-bool Graph::is_connected() const {
-  if (verts.empty())
-    return true;
-
-  std::map<Vertex, std::vector<Vertex>> adjlist;
-  for (Edge e : edges) {
-    adjlist[e.src].push_back(e.dst);
-    adjlist[e.dst].push_back(e.src);
-  }
-
-  std::stack<Vertex> stack;
-  std::set<Vertex> seen;
-
-  stack.push(*verts.begin());
-  seen.insert(stack.top());
-
-  while (!stack.empty()) {
-    Vertex u = stack.top();
-    stack.pop();
-
-    for (Vertex v : adjlist[u]) {
-      if (seen.count(v))
-        continue;
-      seen.insert(v);
-      stack.push(v);
-    }
-  }
-
-  return seen.size() == verts.size();
-}
+// Checked on the CSR form, whose flat rows and bitmap of seen ids replace a
+// map adjacency list and a set of seen vertices
+bool Graph::is_connected() const { return CompactGraph(*this).is_connected(); }
 
 bool Graph::is_tree() const {
   return edges.size() == verts.size() - 1 && is_connected();
@@ -1,49 +1,63 @@
 #include "bfs.hpp"
 
 #include <map>
+#include <optional>
 #include <queue>
 
 namespace interval_mist::graph::bfs {
 
-using Edge = Graph::Edge;
+// BFS over a graph exposing dense ids in canonical order
+template <typename G>
+static std::map<Vertex, Vertex> bfs_parents_of(const G &g, Vertex u) {
+  using Id = typename G::Id;
 
-std::map<Vertex, Vertex> bfs_parents(Graph g, Vertex u) {
-  auto [vs, es] = g;
-
-  if (!vs.count(u)) {
+  auto root = g.id_of(u);
+  if (!root) {
     return {};
   }
 
-  // Construct adjacency list
-  std::map<Vertex, std::set<Vertex>> adjlist;
-  for (auto [u, v] : es) {
-    adjlist[u].insert(v);
-    adjlist[v].insert(u);
-  }
-
-  std::map<Vertex, Vertex> parents;
-  std::queue<Vertex> queue;
+  std::vector<std::optional<Id>> parent_ids(g.num_verts());
+  std::queue<Id> queue;
 
-  parents.emplace(u, u);
-  queue.push(u);
+  parent_ids[root.value()] = root.value();
+  queue.push(root.value());
 
   while (!queue.empty()) {
-    Vertex curr = queue.front(); queue.pop();
+    Id curr = queue.front(); queue.pop();
 
-    for (Vertex next : adjlist[curr]) {
-      if (!parents.count(next)) {
-        parents.emplace(next, curr);
+    for (Id next : g.neighbours(curr)) {
+      if (!parent_ids[next]) {
+        parent_ids[next] = curr;
         queue.push(next);
       }
     }
   }
 
+  std::map<Vertex, Vertex> parents;
+  for (Id v = 0; v < g.num_verts(); ++v) {
+    if (parent_ids[v]) {
+      parents.emplace(g.vertex(v), g.vertex(parent_ids[v].value()));
+    }
+  }
+
   return parents;
 }
 
-std::map<Vertex, std::vector<Vertex>> leaf_paths(Graph g, Vertex u) {
-  auto parents = bfs_parents(g, u);
+std::map<Vertex, Vertex> bfs_parents(Graph g, Vertex u) {
+  return bfs_parents_of(CompactGraph(g), u);
+}
 
+std::map<Vertex, Vertex> bfs_parents(const IntervalGraph &g, Vertex u) {
+  return bfs_parents_of(g, u);
+}
+
+std::map<Vertex, Vertex> bfs_parents(const CompactGraph &g, Vertex u) {
+  return bfs_parents_of(g, u);
+}
+
+// Path from every leaf of a BFS tree back to its root
+static std::map<Vertex, std::vector<Vertex>>
+leaf_paths_from_parents(const std::map<Vertex, Vertex> &parents) {
   std::map<Vertex, size_t> degrees;
   for (auto [u, v] : parents) {
     if (u == v) continue;
@@ -66,4 +80,18 @@ std::map<Vertex, std::vector<Vertex>> leaf_paths(Graph g, Vertex u) {
   return paths;
 }
 
+std::map<Vertex, std::vector<Vertex>> leaf_paths(Graph g, Vertex u) {
+  return leaf_paths_from_parents(bfs_parents(g, u));
+}
+
+std::map<Vertex, std::vector<Vertex>> leaf_paths(const IntervalGraph &g,
+                                                 Vertex u) {
+  return leaf_paths_from_parents(bfs_parents(g, u));
+}
+
+std::map<Vertex, std::vector<Vertex>> leaf_paths(const CompactGraph &g,
+                                                 Vertex u) {
+  return leaf_paths_from_parents(bfs_parents(g, u));
+}
+
 } // namespace interval_mist::graph::bfs
\ No newline at end of file
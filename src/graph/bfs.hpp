@@ -1,17 +1,31 @@
 #pragma once
 
+#include "../compact_graph.hpp"
 #include "../graph.hpp"
+#include "../interval_graph.hpp"
 
 #include <map>
 #include <vector>
 
 namespace interval_mist::graph::bfs {
 
+using CompactGraph = interval_mist::graph::CompactGraph;
 using Graph = interval_mist::graph::Graph;
+using IntervalGraph = interval_mist::graph::IntervalGraph;
 using Vertex = Graph::Vertex;
 
 std::map<Vertex, Vertex> bfs_parents(Graph g, Vertex u);
 
+std::map<Vertex, Vertex> bfs_parents(const IntervalGraph &g, Vertex u);
+
+std::map<Vertex, Vertex> bfs_parents(const CompactGraph &g, Vertex u);
+
 std::map<Vertex, std::vector<Vertex>> leaf_paths(Graph g, Vertex u);
 
+std::map<Vertex, std::vector<Vertex>> leaf_paths(const IntervalGraph &g,
+                                                 Vertex u);
+
+std::map<Vertex, std::vector<Vertex>> leaf_paths(const CompactGraph &g,
+                                                 Vertex u);
+
 } // namespace interval_mist::graph::bfs
\ No newline at end of file
@@ -128,4 +128,15 @@ TEST(LeafPathsTest, RootLeafTree) {
   EXPECT_EQ(expected, actual);
 }
 
+TEST(LeafPathsTest, IntervalGraph) {
+  for (size_t seed = 0; seed < 20; ++seed) {
+    auto vs = interval::random_connected_interval_set(seed, 20);
+    Graph g = Graph::interval_graph_from_set(vs);
+    for (Vertex v : vs) {
+      EXPECT_EQ(bfs_parents(g, v), bfs_parents(IntervalGraph(vs), v));
+      EXPECT_EQ(leaf_paths(g, v), leaf_paths(IntervalGraph(vs), v));
+    }
+  }
+}
+
 } // namespace interval_mist::graph::bfs
\ No newline at end of file
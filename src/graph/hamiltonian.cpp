@@ -1,59 +1,402 @@
 #include "hamiltonian.hpp"
 
-#include <map>
-#include <set>
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <vector>
 
 namespace interval_mist::graph::hamiltonian {
 
+using Coord = Interval::Coord;
 using Vertex = Graph::Vertex;
-using Edge = Graph::Edge;
 
-std::optional<std::vector<Graph::Vertex>> hamiltonian(Graph g) {
-  auto [vs, es] = g;
+// Greedy over a graph exposing dense ids in canonical order and a
+// find_neighbour(u, pred) query for the LRE neighbour satisfying pred
+template <typename G>
+static std::optional<std::vector<Vertex>> greedy_path(const G &g) {
+  using Id = typename G::Id;
 
-  if (vs.empty()) {
+  if (g.num_verts() == 0) {
     return {{}};
   }
 
-  // Construct adjacency list
-  std::map<Vertex, std::set<Vertex>> adjlist;
-  for (auto [u, v] : es) {
-    assert(vs.count(u));
-    assert(vs.count(v));
-    adjlist[u].insert(v);
-    adjlist[v].insert(u);
+  // Vertices already in the path
+  std::vector<bool> seen(g.num_verts());
+  auto unseen = [&seen](Id v) { return !seen[v]; };
+
+  // Start with LRE vertex and repeatedly extend by LRE unseen neighbour
+  std::vector<Vertex> path = {g.vertex(0)};
+  seen[0] = true;
+  for (Id curr = 0; path.size() < g.num_verts();) {
+    auto next = g.find_neighbour(curr, unseen);
+    if (!next)
+      return {};
+    curr = next.value();
+    seen[curr] = true;
+    path.push_back(g.vertex(curr));
   }
 
-  // Remaining vertices to add to path so far
-  std::set<Vertex> todo(vs.begin(), vs.end());
+  return {path};
+}
 
-  // Path so far
-  std::vector<Vertex> path;
+// Unvisited intervals of a greedy path. Every unvisited interval ends at or
+// after the current one starts, so its unvisited neighbours are exactly those
+// starting by the point it ends, and the next step is the first of those.
+//
+// The intervals form a Cartesian tree: in index order, and a min-heap on left
+// endpoints with earlier indices above on ties. The search walks the tree in
+// order from the first unvisited interval, skipping every subtree whose root
+// starts too late. A visited interval with no left child is spliced out, as
+// is each visited ancestor it leaves without one. Any other visited interval
+// stays in the tree until its left subtree is gone.
+class Unvisited {
+public:
+  Unvisited(std::span<const Interval> is)
+      : is(is), left(is.size(), none), right(is.size(), none),
+        parent(is.size(), none), visited(is.size()) {
+    assert(is.size() < none);
+    std::vector<Id> spine;
+    for (Id i = 0; i < is.size(); ++i) {
+      Id last = none;
+      while (!spine.empty() && is[spine.back()].lower > is[i].lower) {
+        last = spine.back();
+        spine.pop_back();
+      }
+      if (last != none) {
+        left[i] = last;
+        parent[last] = i;
+      }
+      if (!spine.empty()) {
+        right[spine.back()] = i;
+        parent[i] = spine.back();
+      }
+      spine.push_back(i);
+    }
+  }
 
-  // Start with LRE vertex
-  path.push_back(*todo.begin());
-  todo.erase(todo.begin());
-
-  // While there are vertices not yet in the path
-  while (!todo.empty()) {
-    // Select adjacent vertex to prev with LRE
-    std::optional<Vertex> curr;
-    for (auto v : adjlist[path.back()]) {
-      if (todo.count(v)) {
-        curr = v;
+  // First unvisited interval starting at or before x, or is.size() if none
+  size_t first_at_most(Coord x) {
+    while (first < is.size() && visited[first])
+      ++first;
+    if (first == is.size())
+      return is.size();
+
+    // Everything before first is visited, so start by looking right of it
+    Id v = first;
+    for (bool down = false;;) {
+      while (down && left[v] != none && is[left[v]].lower <= x)
+        v = left[v];
+      if (is[v].lower <= x) {
+        if (!visited[v])
+          return v;
+        // Next in order is the start of the right subtree
+        down = right[v] != none && is[right[v]].lower <= x;
+        if (down) {
+          v = right[v];
+          continue;
+        }
+      }
+      // Otherwise the first ancestor after v in index order
+      while (parent[v] != none && right[parent[v]] == v)
+        v = parent[v];
+      if (parent[v] == none)
+        return is.size();
+      v = parent[v];
+    }
+  }
+
+  void erase(size_t i) {
+    visited[i] = true;
+    for (Id v = i; left[v] == none;) {
+      // Replace v by its right subtree
+      Id p = parent[v], c = right[v];
+      if (c != none)
+        parent[c] = p;
+      if (p != none)
+        (left[p] == v ? left[p] : right[p]) = c;
+      if (p == none || !visited[p])
         break;
+      v = p;
+    }
+  }
+
+private:
+  using Id = uint32_t;
+
+  static constexpr Id none = std::numeric_limits<Id>::max();
+
+  std::span<const Interval> is;
+  std::vector<Id> left, right, parent;
+  std::vector<bool> visited;
+  size_t first = 0;
+};
+
+// Maximum over a range of positions, each holding a value to which constants
+// can be added a range at a time, as a segment tree of 2^k leaves. Each node
+// holds the maximum below it plus whatever was added to it as a whole, which
+// a query first pushes down to the nodes it reads.
+class MaxTree {
+public:
+  struct Max {
+    int64_t value;
+    size_t index;
+  };
+
+  MaxTree(size_t n)
+      : leaves(std::bit_ceil(n)), height(std::countr_zero(leaves)) {
+    best.resize(2 * leaves);
+    added.resize(leaves);
+    for (size_t i = 0; i < leaves; ++i) {
+      best[leaves + i] = {0, i};
+    }
+    for (size_t node = leaves - 1; node > 0; --node) {
+      best[node] = larger(best[2 * node], best[2 * node + 1]);
+    }
+  }
+
+  void add(size_t begin, size_t end, int64_t d) {
+    if (begin >= end)
+      return;
+    size_t lo = begin + leaves, hi = end + leaves;
+    for (size_t l = lo, r = hi; l < r; l >>= 1, r >>= 1) {
+      if (l & 1)
+        apply(l++, d);
+      if (r & 1)
+        apply(--r, d);
+    }
+    // Nothing was added left of a prefix, or either side of a single leaf
+    if (begin > 0 && end - begin > 1)
+      rebuild(lo);
+    rebuild(hi - 1);
+  }
+
+  // Largest value in the range, the first if several are equal
+  Max max(size_t begin, size_t end) {
+    assert(begin < end);
+    size_t lo = begin + leaves, hi = end + leaves;
+    if (begin > 0)
+      push(lo);
+    push(hi - 1);
+    Max left = {std::numeric_limits<int64_t>::min(), 0}, right = left;
+    for (size_t l = lo, r = hi; l < r; l >>= 1, r >>= 1) {
+      if (l & 1)
+        left = larger(left, best[l++]);
+      if (r & 1)
+        right = larger(best[--r], right);
+    }
+    return larger(left, right);
+  }
+
+private:
+  size_t leaves, height;
+  std::vector<Max> best;
+  std::vector<int64_t> added;
+
+  static Max larger(Max a, Max b) { return b.value > a.value ? b : a; }
+
+  void apply(size_t node, int64_t d) {
+    best[node].value += d;
+    if (node < leaves)
+      added[node] += d;
+  }
+
+  // Recomputes the ancestors of a leaf from their children
+  void rebuild(size_t node) {
+    for (node >>= 1; node > 0; node >>= 1) {
+      best[node] = larger(best[2 * node], best[2 * node + 1]);
+      best[node].value += added[node];
+    }
+  }
+
+  // Moves what was added to the ancestors of a leaf down to their children
+  void push(size_t node) {
+    for (size_t shift = height; shift > 0; --shift) {
+      size_t above = node >> shift;
+      if (added[above] != 0) {
+        apply(2 * above, added[above]);
+        apply(2 * above + 1, added[above]);
+        added[above] = 0;
       }
     }
+  }
+};
+
+// Separator whose removal leaves at least removed.size() + excess components,
+// if there is one, looking only at sets of intervals crossing some set of cut
+// points. That is enough for interval graphs: excess 2 finds one exactly when
+// there is no Hamiltonian path, and excess 1 when there is no Hamiltonian
+// cycle (on three or more vertices), since such graphs are Hamiltonian
+// exactly when they are 1-tough.
+//
+// A cut need only be tried just after each distinct right endpoint u_j, so
+// it removes the intervals with lower <= u_j < upper. Consecutive cuts u_i,
+// u_j bound a region, and only whether it holds some interval matters: were
+// there two components in it, cutting between them would remove nothing new.
+// So with f(j) the best of components less removals over cuts ending at u_j,
+//
+//   f(j) = max over i < j of f(i) + [some interval lies in (u_i, u_j]]
+//                                 - #{w : u_i < lower(w) <= u_j < upper(w)}
+//
+// where i = 0 stands for no earlier cut. Sweeping j, a max-tree over i keeps
+// f(i) less the count, which each interval w lowers over the prefix of i
+// with u_i < lower(w) while it crosses u_j.
+static std::optional<Separator> separator(std::span<const Interval> is,
+                                          size_t excess) {
+  size_t n = is.size();
+  std::vector<Coord> uppers;
+  for (const Interval &v : is) {
+    if (uppers.empty() || uppers.back() != v.upper)
+      uppers.push_back(v.upper);
+  }
+  // Cuts after the last right endpoint remove nothing from the regions, but
+  // a cycle separator must remove something from a connected graph
+  size_t num_cuts = uppers.size() - (excess == 1);
+  if (uppers.empty() || num_cuts == 0)
+    return {};
 
-    if (curr) {
-      path.push_back(curr.value());
-      todo.erase(curr.value());
+  // Cut j, counting from 1, is after uppers[j - 1]. Interval w crosses cuts
+  // starts[w] to ends[w] - 1.
+  auto cut_at = [&uppers](Coord c) {
+    return std::lower_bound(uppers.begin(), uppers.end(), c) -
+           uppers.begin() + 1;
+  };
+  std::vector<size_t> starts(n), ends(n), crossing_from(num_cuts + 1);
+  for (size_t w = 0; w < n; ++w) {
+    starts[w] = cut_at(is[w].lower);
+    ends[w] = cut_at(is[w].upper);
+    if (starts[w] < ends[w])
+      ++crossing_from[starts[w]];
+  }
+
+  Coord max_lower = 0;
+  for (const Interval &v : is) {
+    max_lower = std::max(max_lower, v.lower);
+  }
+
+  // Every cut so far loses one for each interval starting to cross here, so
+  // the tree holds each value less that running total
+  MaxTree tree(num_cuts);
+  int64_t offset = 0;
+  std::vector<int64_t> f(num_cuts + 1);
+  std::vector<size_t> previous(num_cuts + 1);
+  // Latest left endpoint of an interval ending by the current cut
+  Coord region_lower = 0;
+  size_t best = 0, next = 0;
+  for (size_t j = 1; j <= num_cuts; ++j) {
+    tree.add(j - 1, j, f[j - 1] - offset);
+    offset -= crossing_from[j];
+    for (; next < n && ends[next] == j; ++next) {
+      region_lower = std::max(region_lower, is[next].lower);
+      if (starts[next] < j)
+        tree.add(0, starts[next], 1);
+    }
+
+    // Earlier cuts far enough back to leave an interval between them and
+    // this one, and the rest
+    size_t earliest = cut_at(region_lower);
+    MaxTree::Max apart = tree.max(0, earliest);
+    MaxTree::Max near = earliest < j ? tree.max(earliest, j) : apart;
+    if (apart.value + 1 > near.value) {
+      f[j] = offset + apart.value + 1;
+      previous[j] = apart.index;
     } else {
-      return {};
+      f[j] = offset + near.value;
+      previous[j] = near.index;
     }
+    if (best == 0 || f[j] + (uppers[j - 1] < max_lower) >
+                         f[best] + (uppers[best - 1] < max_lower))
+      best = j;
   }
+  if (f[best] + (uppers[best - 1] < max_lower) < int64_t(excess))
+    return {};
 
-  return {path};
+  // Intervals crossing the chosen cuts, then components of the rest
+  std::vector<size_t> chosen(num_cuts + 2);
+  for (size_t j = best; j > 0; j = previous[j]) {
+    chosen[j] = 1;
+  }
+  for (size_t j = 1; j < chosen.size(); ++j) {
+    chosen[j] += chosen[j - 1];
+  }
+  Separator result{.removed = {}, .components = 0};
+  std::vector<int64_t> crossings(uppers.size() + 2);
+  std::vector<bool> ends_here(uppers.size() + 1);
+  for (size_t w = 0; w < n; ++w) {
+    size_t last = std::min(ends[w], num_cuts + 1) - 1;
+    if (starts[w] < ends[w] && chosen[last] > chosen[starts[w] - 1]) {
+      result.removed.push_back(w);
+      continue;
+    }
+    ends_here[ends[w]] = true;
+    ++crossings[starts[w]];
+    --crossings[ends[w]];
+  }
+  int64_t crossing = 0;
+  for (size_t j = 1; j <= uppers.size(); ++j) {
+    crossing += crossings[j];
+    if (ends_here[j] && crossing == 0)
+      ++result.components;
+  }
+  assert(result.components >= result.removed.size() + excess);
+  return result;
+}
+
+std::variant<std::vector<size_t>, Separator>
+hamiltonian_path(std::span<const Interval> is) {
+  if (is.empty())
+    return std::vector<size_t>();
+
+  Unvisited unvisited(is);
+  std::vector<size_t> path = {0};
+  unvisited.erase(0);
+  while (path.size() < is.size()) {
+    size_t next = unvisited.first_at_most(is[path.back()].upper);
+    if (next == is.size()) {
+      auto result = separator(is, 2);
+      assert(result.has_value());
+      return std::move(result.value());
+    }
+    unvisited.erase(next);
+    path.push_back(next);
+  }
+  return path;
+}
+
+std::optional<Separator> cycle_separator(std::span<const Interval> is) {
+  return separator(is, 1);
+}
+
+bool has_hamiltonian_cycle(std::span<const Interval> is) {
+  return is.size() >= 3 && !cycle_separator(is);
+}
+
+// Vertices of vs in the order of their Hamiltonian path, if there is one
+static std::optional<std::vector<Vertex>>
+vertex_path(std::span<const Vertex> vs) {
+  auto result = hamiltonian_path(vs);
+  const auto *order = std::get_if<std::vector<size_t>>(&result);
+  if (!order)
+    return {};
+  std::vector<Vertex> path;
+  path.reserve(order->size());
+  for (size_t i : *order) {
+    path.push_back(vs[i]);
+  }
+  return path;
+}
+
+std::optional<std::vector<Vertex>> hamiltonian(Graph g) {
+  return greedy_path(CompactGraph(g));
+}
+
+std::optional<std::vector<Vertex>> hamiltonian(const IntervalGraph &g) {
+  return vertex_path(g.vertices());
+}
+
+std::optional<std::vector<Vertex>> hamiltonian(const CompactGraph &g) {
+  return greedy_path(g);
 }
 
-} // namespace interval_mist::graph::hamiltonian
\ No newline at end of file
+} // namespace interval_mist::graph::hamiltonian
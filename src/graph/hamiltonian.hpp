@@ -1,14 +1,57 @@
 #pragma once
 
+#include "../compact_graph.hpp"
 #include "../graph.hpp"
+#include "../interval.hpp"
+#include "../interval_graph.hpp"
 
 #include <optional>
+#include <span>
+#include <variant>
 #include <vector>
 
 namespace interval_mist::graph::hamiltonian {
 
+using CompactGraph = interval_mist::graph::CompactGraph;
 using Graph = interval_mist::graph::Graph;
+using Interval = interval_mist::interval::Interval;
+using IntervalGraph = interval_mist::graph::IntervalGraph;
 
+// Intervals whose removal splits the rest into more connected components than
+// a Hamiltonian path or cycle could pass through, as indices in canonical
+// order. A path can pass through at most removed.size() + 1 of them, and a
+// cycle at most removed.size().
+struct Separator {
+  std::vector<size_t> removed;
+  // Components of the intervals left
+  size_t components;
+};
+
+// Hamiltonian path of the interval graph of is, which must be distinct and in
+// canonical order, as indices into is. It is found greedily. The path starts
+// at the first interval and repeatedly moves to the first unvisited interval
+// meeting the last one. This succeeds whenever any Hamiltonian path exists,
+// and takes O(n) without building any edges, so is may be a sub-range of a
+// larger array. When the greedy gets stuck, returns instead a Separator
+// leaving at least removed.size() + 2 components, found in O(n log n).
+std::variant<std::vector<size_t>, Separator>
+hamiltonian_path(std::span<const Interval> is);
+
+// Separator leaving more components than it removes, proving the interval
+// graph of is (distinct and in canonical order) has no Hamiltonian cycle, or
+// nothing if it has one. O(n log n) without building any edges. Graphs on
+// fewer than three vertices have no Hamiltonian cycle even when there is no
+// such separator.
+std::optional<Separator> cycle_separator(std::span<const Interval> is);
+
+bool has_hamiltonian_cycle(std::span<const Interval> is);
+
+// Follows the edges of g, which need not be those of the interval graph of its
+// vertices
 std::optional<std::vector<Graph::Vertex>> hamiltonian(Graph g);
 
-} // namespace interval_mist::graph::hamiltonian
\ No newline at end of file
+std::optional<std::vector<Graph::Vertex>> hamiltonian(const IntervalGraph &g);
+
+std::optional<std::vector<Graph::Vertex>> hamiltonian(const CompactGraph &g);
+
+} // namespace interval_mist::graph::hamiltonian
@@ -2,6 +2,10 @@
 
 #include "hamiltonian.hpp"
 
+#include <random>
+#include <set>
+#include <vector>
+
 namespace interval_mist::graph::hamiltonian {
 
 using Vertex = Graph::Vertex;
@@ -52,4 +56,149 @@ TEST(HamiltonianTest, Simple) {
   EXPECT_EQ(expected, actual);
 }
 
+TEST(HamiltonianTest, IntervalGraph) {
+  for (size_t seed = 0; seed < 50; ++seed) {
+    auto vs = interval::random_connected_interval_set(seed, 12);
+    Graph g = Graph::interval_graph_from_set(vs);
+    EXPECT_EQ(hamiltonian(g), hamiltonian(IntervalGraph(vs)));
+  }
+}
+
+TEST(HamiltonianTest, FollowsGraphEdges) {
+  // All three intervals meet, but only a and b are joined
+  Vertex a = Vertex(0, 10), b = Vertex(1, 11), c = Vertex(2, 12);
+  Graph g = Graph({a, b, c}, {Graph::Edge(a, b)});
+  EXPECT_EQ(std::nullopt, hamiltonian(g));
+  EXPECT_EQ(hamiltonian(CompactGraph(g)), hamiltonian(g));
+}
+
+// Random distinct intervals in canonical order, often disconnected
+static std::vector<Vertex> random_intervals(std::mt19937 &gen, size_t n) {
+  std::uniform_int_distribution<Vertex::Coord> coord(0, 2 * n);
+  std::set<Vertex> vs;
+  while (vs.size() < n) {
+    auto a = coord(gen), b = coord(gen);
+    vs.insert(Vertex(std::min(a, b), std::max(a, b)));
+  }
+  return std::vector<Vertex>(vs.begin(), vs.end());
+}
+
+// Components of the intervals not removed, by union-find over every pair
+static size_t components(std::span<const Vertex> vs,
+                         const std::vector<size_t> &removed) {
+  std::vector<size_t> root(vs.size());
+  for (size_t i = 0; i < vs.size(); ++i) {
+    root[i] = i;
+  }
+  auto find = [&root](size_t i) {
+    while (root[i] != i)
+      i = root[i];
+    return i;
+  };
+  std::set<size_t> gone(removed.begin(), removed.end());
+  size_t count = vs.size() - gone.size();
+  for (size_t i = 0; i < vs.size(); ++i) {
+    for (size_t j = i + 1; j < vs.size(); ++j) {
+      if (gone.count(i) || gone.count(j) || !vs[i].intersects(vs[j]))
+        continue;
+      size_t a = find(i), b = find(j);
+      if (a != b) {
+        root[a] = b;
+        --count;
+      }
+    }
+  }
+  return count;
+}
+
+// Whether some Hamiltonian cycle exists, by search over subsets
+static bool brute_force_cycle(std::span<const Vertex> vs) {
+  size_t n = vs.size();
+  if (n < 3)
+    return false;
+  // reach[mask][v]: a path from 0 through exactly mask ending at v
+  std::vector<std::vector<bool>> reach(1 << n, std::vector<bool>(n));
+  reach[1][0] = true;
+  for (size_t mask = 1; mask < reach.size(); mask += 2) {
+    for (size_t v = 0; v < n; ++v) {
+      if (!reach[mask][v])
+        continue;
+      for (size_t w = 0; w < n; ++w) {
+        if (!(mask >> w & 1) && vs[v].intersects(vs[w]))
+          reach[mask | 1 << w][w] = true;
+      }
+    }
+  }
+  for (size_t v = 1; v < n; ++v) {
+    if (reach.back()[v] && vs[v].intersects(vs[0]))
+      return true;
+  }
+  return false;
+}
+
+TEST(HamiltonianTest, Separator) {
+  // The intervals of NoHamiltonian, in canonical order
+  std::vector<Vertex> vs = {
+    Vertex(0, 2),
+    Vertex(3, 4),
+    Vertex(1, 6),
+    Vertex(7, 8),
+    Vertex(5, 10),
+    Vertex(9, 11),
+  };
+  auto result = hamiltonian_path(vs);
+  ASSERT_TRUE(std::holds_alternative<Separator>(result));
+  const Separator &s = std::get<Separator>(result);
+  EXPECT_GE(s.components, s.removed.size() + 2);
+  EXPECT_EQ(s.components, components(vs, s.removed));
+}
+
+TEST(HamiltonianTest, MatchesAdjacencyGreedy) {
+  std::mt19937 gen(0);
+  for (size_t n = 1; n <= 40; ++n) {
+    for (size_t k = 0; k < 20; ++k) {
+      auto vs = random_intervals(gen, n);
+      IntervalGraph g(vs);
+      EXPECT_EQ(hamiltonian(CompactGraph(g)), hamiltonian(g));
+
+      auto result = hamiltonian_path(vs);
+      if (const auto *s = std::get_if<Separator>(&result)) {
+        EXPECT_GE(s->components, s->removed.size() + 2);
+        EXPECT_EQ(s->components, components(vs, s->removed));
+      }
+    }
+  }
+}
+
+TEST(HamiltonianTest, Cycle) {
+  std::mt19937 gen(1);
+  for (size_t n = 1; n <= 10; ++n) {
+    for (size_t k = 0; k < 40; ++k) {
+      auto vs = random_intervals(gen, n);
+      EXPECT_EQ(brute_force_cycle(vs), has_hamiltonian_cycle(vs));
+      if (auto s = cycle_separator(vs)) {
+        EXPECT_GT(s->components, s->removed.size());
+        EXPECT_EQ(s->components, components(vs, s->removed));
+      }
+    }
+  }
+}
+
+TEST(HamiltonianTest, SubRange) {
+  auto vs = interval::random_connected_intervals(0, 200);
+  std::span<const Vertex> all(vs);
+  for (size_t begin = 0; begin < vs.size(); begin += 37) {
+    auto part = all.subspan(begin, std::min<size_t>(50, vs.size() - begin));
+    std::vector<Vertex> copy(part.begin(), part.end());
+    auto lhs = hamiltonian_path(part), rhs = hamiltonian_path(copy);
+    ASSERT_EQ(lhs.index(), rhs.index());
+    if (lhs.index() == 0) {
+      EXPECT_EQ(std::get<0>(lhs), std::get<0>(rhs));
+    } else {
+      EXPECT_EQ(std::get<1>(lhs).removed, std::get<1>(rhs).removed);
+    }
+    EXPECT_EQ(has_hamiltonian_cycle(part), has_hamiltonian_cycle(copy));
+  }
+}
+
 } // namespace interval_mist::graph::hamiltonian
\ No newline at end of file
@@ -2,9 +2,12 @@
 #include "bfs.hpp"
 #include "hamiltonian.hpp"
 
+#include <algorithm>
 #include <iostream>
 #include <map>
 #include <set>
+#include <variant>
+#include <vector>
 
 namespace interval_mist::graph::tree_transform {
 
@@ -44,9 +47,16 @@ std::optional<Graph> lre_leaf_transform(Graph g) {
     }
 
     // Find the greedy hamiltonian ordering of the path
-    auto maybe_ham_path = hamiltonian::hamiltonian(Graph::interval_graph_from_set(std::set<Vertex>(path.begin(), path.end())));
-    assert(maybe_ham_path.has_value());
-    auto ham_path = maybe_ham_path.value();
+    std::vector<Vertex> path_verts(path.begin(), path.end());
+    std::sort(path_verts.begin(), path_verts.end());
+    path_verts.erase(std::unique(path_verts.begin(), path_verts.end()),
+                     path_verts.end());
+    auto order = hamiltonian::hamiltonian_path(path_verts);
+    assert(std::holds_alternative<std::vector<size_t>>(order));
+    std::vector<Vertex> ham_path;
+    for (size_t i : std::get<std::vector<size_t>>(order)) {
+      ham_path.push_back(path_verts[i]);
+    }
 
     // Insert new path edges into tree
     prev = ham_path.front();
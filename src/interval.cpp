@@ -1,19 +1,11 @@
 #include "interval.hpp"
 
+#include <bit>
 #include <random>
 #include <vector>
 
 namespace interval_mist::interval {
 
-// TODO: Consider implementing hash and using unordered maps and sets where
-// appropriate template<> struct std::hash<Interval> {
-//   std::size_t operator()(const Interval &interval) const noexcept {
-//     const uint64_t upr = static_cast<uint64_t>(interval.upper);
-//     const uint64_t lwr = static_cast<uint64_t>(interval.lower);
-//     return std::hash<uint64_t>(upr << 32 | lwr);
-//   }
-// }
-
 using Coord = Interval::Coord;
 
 Interval::Interval(Coord lwr, Coord upr) : upper(upr), lower(lwr) {
@@ -25,32 +17,87 @@ std::ostream &operator<<(std::ostream &os, const Interval &val) {
   return os;
 }
 
-bool Interval::intersects(const Interval &rhs) {
+bool Interval::intersects(const Interval &rhs) const {
   return lower <= rhs.upper && rhs.lower <= upper;
 }
 
-std::set<Interval> random_connected_interval_set(size_t seed, size_t num) {
+// Intervals opened but not yet closed, numbered by the order they opened, as
+// a bitset with the count of each word kept in a Fenwick tree so that the k-th
+// can be found and removed in O(log n)
+struct OpenIntervals {
+  std::vector<uint64_t> words;
+  std::vector<size_t> tree;
+  std::vector<Coord> lowers;
+  size_t size = 0;
+
+  OpenIntervals(size_t capacity)
+      : words((capacity + 63) / 64), tree(words.size() + 1) {
+    lowers.reserve(capacity);
+  }
+
+  void push(Coord lower) {
+    size_t i = lowers.size();
+    lowers.push_back(lower);
+    words[i / 64] |= uint64_t(1) << (i % 64);
+    for (size_t w = i / 64 + 1; w < tree.size(); w += w & -w) {
+      ++tree[w];
+    }
+    ++size;
+  }
+
+  // Removes the k-th open interval, returning its lower endpoint
+  Coord erase(size_t k) {
+    // Find the word holding it by descending the Fenwick tree
+    size_t w = 0;
+    for (size_t step = std::bit_floor(tree.size()); step > 0; step /= 2) {
+      if (w + step < tree.size() && tree[w + step] <= k) {
+        w += step;
+        k -= tree[w];
+      }
+    }
+
+    uint64_t word = words[w];
+    for (; k > 0; --k) {
+      word &= word - 1;
+    }
+    size_t i = 64 * w + std::countr_zero(word);
+
+    words[w] &= ~(uint64_t(1) << (i % 64));
+    for (size_t v = w + 1; v < tree.size(); v += v & -v) {
+      --tree[v];
+    }
+    --size;
+    return lowers[i];
+  }
+};
+
+std::vector<Interval> random_connected_intervals(size_t seed, size_t num) {
   std::default_random_engine rng(seed);
   std::uniform_int_distribution<uint8_t> bool_dist(0, 1);
 
-  std::vector<Coord> open;
-  std::set<Interval> is;
+  OpenIntervals open(num);
+  std::vector<Interval> is;
+  is.reserve(num);
   Coord limit = 2 * num;
   for (Coord coord = 0; coord < limit; ++coord) {
-    bool must_close = (limit - coord) == open.size();
-    bool must_open = open.size() <= 1 && !must_close;
+    bool must_close = (limit - coord) == open.size;
+    bool must_open = open.size <= 1 && !must_close;
     bool do_open = must_open || (!must_close && bool_dist(rng));
     if (do_open) {
-      open.push_back(coord);
+      open.push(coord);
     } else {
-      auto it = open.begin() +
-                std::uniform_int_distribution<size_t>(0, open.size() - 1)(rng);
-      is.emplace(*it, coord);
-      open.erase(it);
+      size_t k =
+          std::uniform_int_distribution<size_t>(0, open.size - 1)(rng);
+      is.emplace_back(open.erase(k), coord);
     }
   }
 
   return is;
 }
 
+std::set<Interval> random_connected_interval_set(size_t seed, size_t num) {
+  auto is = random_connected_intervals(seed, num);
+  return std::set<Interval>(is.begin(), is.end());
+}
+
 } // namespace interval_mist::interval
\ No newline at end of file
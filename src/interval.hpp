@@ -1,8 +1,12 @@
 #pragma once
 
 #include <cassert>
+#include <cstdint>
+#include <functional>
 #include <ostream>
 #include <set>
+#include <span>
+#include <vector>
 
 namespace interval_mist::interval {
 
@@ -21,9 +25,33 @@ struct Interval {
 
   friend std::ostream &operator<<(std::ostream &os, const Interval &val);
 
-  bool intersects(const Interval &rhs);
+  bool intersects(const Interval &rhs) const;
 };
 
+// Read-only view of intervals stored as separate arrays of left and right
+// endpoints, such as a mapped file, indexed like a span of intervals
+struct IntervalArrays {
+  std::span<const Interval::Coord> lower, upper;
+
+  size_t size() const { return lower.size(); }
+
+  Interval operator[](size_t i) const { return Interval(lower[i], upper[i]); }
+};
+
+// Random intervals with distinct endpoints 0, ..., 2 * num - 1 whose interval
+// graph is connected, in canonical order, generated in O(n log n) time
+std::vector<Interval> random_connected_intervals(size_t seed, size_t num);
+
+// As above, as a set
 std::set<Interval> random_connected_interval_set(size_t seed, size_t num);
 
-} // namespace interval_mist::interval
\ No newline at end of file
+} // namespace interval_mist::interval
+
+template <> struct std::hash<interval_mist::interval::Interval> {
+  size_t operator()(
+      const interval_mist::interval::Interval &interval) const noexcept {
+    const uint64_t upr = static_cast<uint64_t>(interval.upper);
+    const uint64_t lwr = static_cast<uint64_t>(interval.lower);
+    return std::hash<uint64_t>{}(upr << 32 | lwr);
+  }
+};
\ No newline at end of file
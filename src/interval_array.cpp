@@ -0,0 +1,297 @@
+#include "interval_array.hpp"
+
+#include <atomic>
+#include <bit>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace interval_mist::interval {
+
+using Coord = Interval::Coord;
+
+// Kernels over the 64 intervals starting at lower and upper
+struct Kernels {
+  Isa isa;
+  uint64_t (*meets)(const Coord *lower, const Coord *upper, Interval x);
+  uint64_t (*between)(const Coord *lower, const Coord *upper, Interval lo,
+                      Interval hi);
+};
+
+static bool meets_one(Coord lower, Coord upper, Interval x) {
+  return lower <= x.upper && x.lower <= upper;
+}
+
+static bool between_one(Coord lower, Coord upper, Interval lo, Interval hi) {
+  Interval v(lower, upper);
+  return lo < v && v < hi;
+}
+
+static uint64_t meets_scalar(const Coord *lower, const Coord *upper,
+                             Interval x) {
+  uint64_t result = 0;
+  for (size_t k = 0; k < 64; ++k) {
+    result |= uint64_t(meets_one(lower[k], upper[k], x)) << k;
+  }
+  return result;
+}
+
+static uint64_t between_scalar(const Coord *lower, const Coord *upper,
+                               Interval lo, Interval hi) {
+  uint64_t result = 0;
+  for (size_t k = 0; k < 64; ++k) {
+    result |= uint64_t(between_one(lower[k], upper[k], lo, hi)) << k;
+  }
+  return result;
+}
+
+#if defined(__x86_64__)
+
+// SSE2 and AVX2 only compare signed lanes, so coordinates are offset by 2^31
+// to keep their order. An interval misses x if it starts after x ends or ends
+// before x starts. Canonical order is by right endpoint, then left.
+
+static uint64_t meets_sse2(const Coord *lower, const Coord *upper,
+                           Interval x) {
+  const __m128i bias = _mm_set1_epi32(INT32_MIN);
+  __m128i xl = _mm_set1_epi32(int32_t(x.lower ^ 0x80000000u));
+  __m128i xu = _mm_set1_epi32(int32_t(x.upper ^ 0x80000000u));
+  uint64_t result = 0;
+  for (size_t k = 0; k < 64; k += 4) {
+    __m128i l = _mm_xor_si128(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(lower + k)), bias);
+    __m128i u = _mm_xor_si128(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(upper + k)), bias);
+    __m128i miss = _mm_or_si128(_mm_cmpgt_epi32(l, xu), _mm_cmpgt_epi32(xl, u));
+    uint64_t hit = ~_mm_movemask_ps(_mm_castsi128_ps(miss)) & 0xf;
+    result |= hit << k;
+  }
+  return result;
+}
+
+static uint64_t between_sse2(const Coord *lower, const Coord *upper,
+                             Interval lo, Interval hi) {
+  const __m128i bias = _mm_set1_epi32(INT32_MIN);
+  __m128i ll = _mm_set1_epi32(int32_t(lo.lower ^ 0x80000000u));
+  __m128i lu = _mm_set1_epi32(int32_t(lo.upper ^ 0x80000000u));
+  __m128i hl = _mm_set1_epi32(int32_t(hi.lower ^ 0x80000000u));
+  __m128i hu = _mm_set1_epi32(int32_t(hi.upper ^ 0x80000000u));
+  uint64_t result = 0;
+  for (size_t k = 0; k < 64; k += 4) {
+    __m128i l = _mm_xor_si128(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(lower + k)), bias);
+    __m128i u = _mm_xor_si128(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(upper + k)), bias);
+    __m128i after_lo = _mm_or_si128(
+        _mm_cmpgt_epi32(u, lu),
+        _mm_and_si128(_mm_cmpeq_epi32(u, lu), _mm_cmpgt_epi32(l, ll)));
+    __m128i before_hi = _mm_or_si128(
+        _mm_cmpgt_epi32(hu, u),
+        _mm_and_si128(_mm_cmpeq_epi32(u, hu), _mm_cmpgt_epi32(hl, l)));
+    __m128i in = _mm_and_si128(after_lo, before_hi);
+    result |= uint64_t(_mm_movemask_ps(_mm_castsi128_ps(in))) << k;
+  }
+  return result;
+}
+
+__attribute__((target("avx2"))) static uint64_t
+meets_avx2(const Coord *lower, const Coord *upper, Interval x) {
+  const __m256i bias = _mm256_set1_epi32(INT32_MIN);
+  __m256i xl = _mm256_set1_epi32(int32_t(x.lower ^ 0x80000000u));
+  __m256i xu = _mm256_set1_epi32(int32_t(x.upper ^ 0x80000000u));
+  uint64_t result = 0;
+  for (size_t k = 0; k < 64; k += 8) {
+    __m256i l = _mm256_xor_si256(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lower + k)),
+        bias);
+    __m256i u = _mm256_xor_si256(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(upper + k)),
+        bias);
+    __m256i miss =
+        _mm256_or_si256(_mm256_cmpgt_epi32(l, xu), _mm256_cmpgt_epi32(xl, u));
+    uint64_t hit = ~_mm256_movemask_ps(_mm256_castsi256_ps(miss)) & 0xff;
+    result |= hit << k;
+  }
+  return result;
+}
+
+__attribute__((target("avx2"))) static uint64_t
+between_avx2(const Coord *lower, const Coord *upper, Interval lo, Interval hi) {
+  const __m256i bias = _mm256_set1_epi32(INT32_MIN);
+  __m256i ll = _mm256_set1_epi32(int32_t(lo.lower ^ 0x80000000u));
+  __m256i lu = _mm256_set1_epi32(int32_t(lo.upper ^ 0x80000000u));
+  __m256i hl = _mm256_set1_epi32(int32_t(hi.lower ^ 0x80000000u));
+  __m256i hu = _mm256_set1_epi32(int32_t(hi.upper ^ 0x80000000u));
+  uint64_t result = 0;
+  for (size_t k = 0; k < 64; k += 8) {
+    __m256i l = _mm256_xor_si256(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lower + k)),
+        bias);
+    __m256i u = _mm256_xor_si256(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(upper + k)),
+        bias);
+    __m256i after_lo = _mm256_or_si256(
+        _mm256_cmpgt_epi32(u, lu),
+        _mm256_and_si256(_mm256_cmpeq_epi32(u, lu), _mm256_cmpgt_epi32(l, ll)));
+    __m256i before_hi = _mm256_or_si256(
+        _mm256_cmpgt_epi32(hu, u),
+        _mm256_and_si256(_mm256_cmpeq_epi32(u, hu), _mm256_cmpgt_epi32(hl, l)));
+    __m256i in = _mm256_and_si256(after_lo, before_hi);
+    result |= uint64_t(_mm256_movemask_ps(_mm256_castsi256_ps(in))) << k;
+  }
+  return result;
+}
+
+// AVX-512 compares unsigned lanes directly, into masks
+__attribute__((target("avx512f"))) static uint64_t
+meets_avx512(const Coord *lower, const Coord *upper, Interval x) {
+  __m512i xl = _mm512_set1_epi32(int32_t(x.lower));
+  __m512i xu = _mm512_set1_epi32(int32_t(x.upper));
+  uint64_t result = 0;
+  for (size_t k = 0; k < 64; k += 16) {
+    __m512i l = _mm512_loadu_si512(lower + k);
+    __m512i u = _mm512_loadu_si512(upper + k);
+    __mmask16 hit = _mm512_cmple_epu32_mask(l, xu) &
+                    _mm512_cmple_epu32_mask(xl, u);
+    result |= uint64_t(hit) << k;
+  }
+  return result;
+}
+
+__attribute__((target("avx512f"))) static uint64_t
+between_avx512(const Coord *lower, const Coord *upper, Interval lo,
+               Interval hi) {
+  __m512i ll = _mm512_set1_epi32(int32_t(lo.lower));
+  __m512i lu = _mm512_set1_epi32(int32_t(lo.upper));
+  __m512i hl = _mm512_set1_epi32(int32_t(hi.lower));
+  __m512i hu = _mm512_set1_epi32(int32_t(hi.upper));
+  uint64_t result = 0;
+  for (size_t k = 0; k < 64; k += 16) {
+    __m512i l = _mm512_loadu_si512(lower + k);
+    __m512i u = _mm512_loadu_si512(upper + k);
+    __mmask16 after_lo =
+        _mm512_cmpgt_epu32_mask(u, lu) |
+        (_mm512_cmpeq_epu32_mask(u, lu) & _mm512_cmpgt_epu32_mask(l, ll));
+    __mmask16 before_hi =
+        _mm512_cmplt_epu32_mask(u, hu) |
+        (_mm512_cmpeq_epu32_mask(u, hu) & _mm512_cmplt_epu32_mask(l, hl));
+    result |= uint64_t(after_lo & before_hi) << k;
+  }
+  return result;
+}
+
+#endif
+
+static const Kernels &best_kernels() {
+#if defined(__x86_64__)
+  __builtin_cpu_init();
+  static const Kernels kernels =
+      __builtin_cpu_supports("avx512f")
+          ? Kernels{Isa::avx512, meets_avx512, between_avx512}
+      : __builtin_cpu_supports("avx2")
+          ? Kernels{Isa::avx2, meets_avx2, between_avx2}
+          : Kernels{Isa::sse2, meets_sse2, between_sse2};
+#else
+  static const Kernels kernels = {Isa::scalar, meets_scalar, between_scalar};
+#endif
+  return kernels;
+}
+
+static std::atomic<const Kernels *> &active() {
+  static std::atomic<const Kernels *> kernels = &best_kernels();
+  return kernels;
+}
+
+std::vector<Isa> supported_isas() {
+  std::vector<Isa> result = {Isa::scalar};
+#if defined(__x86_64__)
+  result.push_back(Isa::sse2);
+  if (__builtin_cpu_supports("avx2"))
+    result.push_back(Isa::avx2);
+  if (__builtin_cpu_supports("avx512f"))
+    result.push_back(Isa::avx512);
+#endif
+  return result;
+}
+
+Isa current_isa() { return active().load()->isa; }
+
+void use_isa(Isa isa) {
+  static const Kernels scalar = {Isa::scalar, meets_scalar, between_scalar};
+#if defined(__x86_64__)
+  static const Kernels sse2 = {Isa::sse2, meets_sse2, between_sse2};
+  static const Kernels avx2 = {Isa::avx2, meets_avx2, between_avx2};
+  static const Kernels avx512 = {Isa::avx512, meets_avx512, between_avx512};
+  const Kernels *all[] = {&scalar, &sse2, &avx2, &avx512};
+  active() = all[size_t(isa)];
+#else
+  active() = &scalar;
+#endif
+}
+
+// Bits of the intervals from i on, 64 at a time with word and one at a time
+// for those short of a full word at the end
+template <typename Word, typename One>
+static uint64_t bits(const IntervalArrays &is, size_t i, Word word, One one) {
+  if (i + 64 <= is.size())
+    return word(is.lower.data() + i, is.upper.data() + i);
+  uint64_t result = 0;
+  for (size_t k = 0; i + k < is.size(); ++k) {
+    result |= uint64_t(one(is.lower[i + k], is.upper[i + k])) << k;
+  }
+  return result;
+}
+
+static uint64_t meets_bits(const IntervalArrays &is, size_t i, Interval x) {
+  return bits(
+      is, i,
+      [x](const Coord *lower, const Coord *upper) {
+        return active().load(std::memory_order_relaxed)->meets(lower, upper, x);
+      },
+      [x](Coord lower, Coord upper) { return meets_one(lower, upper, x); });
+}
+
+std::vector<uint64_t> intersecting(const IntervalArrays &is, Interval x) {
+  std::vector<uint64_t> result((is.size() + 63) / 64);
+  for (size_t w = 0; w < result.size(); ++w) {
+    result[w] = meets_bits(is, 64 * w, x);
+  }
+  return result;
+}
+
+size_t count_intersecting(const IntervalArrays &is, Interval x) {
+  size_t result = 0;
+  for (size_t i = 0; i < is.size(); i += 64) {
+    result += std::popcount(meets_bits(is, i, x));
+  }
+  return result;
+}
+
+size_t first_intersecting(const IntervalArrays &is, Interval x, size_t from) {
+  for (size_t i = from; i < is.size(); i += 64) {
+    if (uint64_t hits = meets_bits(is, i, x))
+      return i + std::countr_zero(hits);
+  }
+  return is.size();
+}
+
+size_t first_between(const IntervalArrays &is, Interval lo, Interval hi,
+                     size_t from) {
+  for (size_t i = from; i < is.size(); i += 64) {
+    uint64_t hits = bits(
+        is, i,
+        [lo, hi](const Coord *lower, const Coord *upper) {
+          return active().load(std::memory_order_relaxed)
+              ->between(lower, upper, lo, hi);
+        },
+        [lo, hi](Coord lower, Coord upper) {
+          return between_one(lower, upper, lo, hi);
+        });
+    if (hits)
+      return i + std::countr_zero(hits);
+  }
+  return is.size();
+}
+
+} // namespace interval_mist::interval
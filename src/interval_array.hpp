@@ -0,0 +1,77 @@
+#pragma once
+
+#include "interval.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace interval_mist::interval {
+
+// Intervals stored as separate arrays of left and right endpoints, so that
+// scans over many of them load whole vectors of each. Views as
+// IntervalArrays, on which the kernels below run.
+struct IntervalArray {
+  using Coord = Interval::Coord;
+
+  std::vector<Coord> lower, upper;
+
+  IntervalArray() = default;
+
+  template <typename It> IntervalArray(It begin, It end) {
+    for (; begin != end; ++begin) {
+      push_back(*begin);
+    }
+  }
+
+  size_t size() const { return lower.size(); }
+
+  Interval operator[](size_t i) const { return Interval(lower[i], upper[i]); }
+
+  void push_back(Interval i) {
+    lower.push_back(i.lower);
+    upper.push_back(i.upper);
+  }
+
+  void clear() {
+    lower.clear();
+    upper.clear();
+  }
+
+  operator IntervalArrays() const { return {lower, upper}; }
+};
+
+// Scans comparing every interval of is against one or two others. Each works
+// on 64 intervals at a time, sixteen to a vector instruction with AVX-512 or
+// eight with AVX2 where the processor has them, else four with SSE2, and one
+// by one off x86-64.
+
+// Instruction sets the scans can use, from narrowest to widest
+enum class Isa { scalar, sse2, avx2, avx512 };
+
+// Those this processor has, in the order above
+std::vector<Isa> supported_isas();
+
+// The one in use, by default the widest supported
+Isa current_isa();
+
+// Switches every scan to isa, which must be supported, so that tests and
+// benchmarks can compare them. Scans already running are unaffected.
+void use_isa(Isa isa);
+
+// Which of is meet x, with bit i % 64 of word i / 64 set if is[i] does
+std::vector<uint64_t> intersecting(const IntervalArrays &is, Interval x);
+
+// Number of is that meet x
+size_t count_intersecting(const IntervalArrays &is, Interval x);
+
+// First i from on with is[i] meeting x, or is.size() if there is none
+size_t first_intersecting(const IntervalArrays &is, Interval x,
+                          size_t from = 0);
+
+// First i from on with lo < is[i] < hi in canonical order, or is.size() if
+// there is none
+size_t first_between(const IntervalArrays &is, Interval lo, Interval hi,
+                     size_t from = 0);
+
+} // namespace interval_mist::interval
@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+
+#include "interval_array.hpp"
+
+#include <random>
+#include <vector>
+
+namespace interval_mist::interval {
+
+using Coord = Interval::Coord;
+
+TEST(IntervalArrayTest, Container) {
+  std::vector<Interval> is = {Interval(0, 3), Interval(2, 5)};
+  IntervalArray a(is.begin(), is.end());
+  EXPECT_EQ(2, a.size());
+  EXPECT_EQ(is[1], a[1]);
+  a.push_back(Interval(4, 4));
+  IntervalArrays view = a;
+  EXPECT_EQ(Interval(4, 4), view[2]);
+  a.clear();
+  EXPECT_EQ(0, a.size());
+}
+
+TEST(IntervalArrayTest, Empty) {
+  IntervalArray a;
+  EXPECT_TRUE(intersecting(a, Interval(0, 1)).empty());
+  EXPECT_EQ(0, count_intersecting(a, Interval(0, 1)));
+  EXPECT_EQ(0, first_intersecting(a, Interval(0, 1)));
+  EXPECT_EQ(0, first_between(a, Interval(0, 1), Interval(2, 3)));
+}
+
+// Every instruction set against one interval at a time, over lengths that
+// end partway through a word and coordinates either side of 2^31
+TEST(IntervalArrayTest, MatchesScalar) {
+  Isa original = current_isa();
+  std::mt19937 gen(0);
+  for (Isa isa : supported_isas()) {
+    use_isa(isa);
+    for (size_t n : {1, 63, 64, 65, 200}) {
+      for (Coord base : {Coord(0), Coord(0x7ffffff0u), Coord(0xffffff00u)}) {
+        std::uniform_int_distribution<Coord> coord(base, base + 60);
+        IntervalArray a;
+        for (size_t i = 0; i < n; ++i) {
+          Coord l = coord(gen), u = coord(gen);
+          a.push_back(Interval(std::min(l, u), std::max(l, u)));
+        }
+        for (size_t trial = 0; trial < 20; ++trial) {
+          Coord l = coord(gen), u = coord(gen);
+          Interval x(std::min(l, u), std::max(l, u));
+          Coord m = coord(gen);
+          Interval y(std::min(m, x.upper), std::max(m, x.upper));
+          Interval lo = std::min(x, y), hi = std::max(x, y);
+
+          auto words = intersecting(a, x);
+          size_t count = 0, first = n, first_in = n;
+          for (size_t i = 0; i < n; ++i) {
+            bool meets = a[i].intersects(x);
+            EXPECT_EQ(meets, bool(words[i / 64] >> i % 64 & 1));
+            count += meets;
+            if (meets && first == n && i >= trial)
+              first = i;
+            if (lo < a[i] && a[i] < hi && first_in == n && i >= trial)
+              first_in = i;
+          }
+          EXPECT_EQ(count, count_intersecting(a, x));
+          EXPECT_EQ(first, first_intersecting(a, x, trial));
+          EXPECT_EQ(first_in, first_between(a, lo, hi, trial));
+        }
+      }
+    }
+  }
+  use_isa(original);
+}
+
+} // namespace interval_mist::interval
@@ -0,0 +1,112 @@
+#include "interval_graph.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <limits>
+
+namespace interval_mist::graph {
+
+using Vertex = IntervalGraph::Vertex;
+using Coord = IntervalGraph::Coord;
+using Id = IntervalGraph::Id;
+
+IntervalGraph::IntervalGraph(std::set<Vertex> vs)
+    : verts(vs.begin(), vs.end()), lower_tree(0) {
+  build_index();
+}
+
+IntervalGraph::IntervalGraph(std::vector<Vertex> vs)
+    : verts(std::move(vs)), lower_tree(0) {
+  std::sort(verts.begin(), verts.end());
+  verts.erase(std::unique(verts.begin(), verts.end()), verts.end());
+  build_index();
+}
+
+void IntervalGraph::assign(std::span<const Vertex> vs) {
+  assert(std::adjacent_find(vs.begin(), vs.end(),
+                            std::greater_equal<Vertex>()) == vs.end());
+  verts.assign(vs.begin(), vs.end());
+  build_index();
+}
+
+void IntervalGraph::build_index() {
+  assert(verts.size() <= std::numeric_limits<Id>::max());
+
+  lowers.clear();
+  for (const Vertex &v : verts) {
+    lowers.push_back(v.lower);
+  }
+  std::sort(lowers.begin(), lowers.end());
+
+  lower_tree.assign(verts);
+}
+
+size_t IntervalGraph::num_verts() const { return verts.size(); }
+
+size_t IntervalGraph::num_edges() const {
+  size_t result = 0;
+  for (Id u = 0; u < verts.size(); ++u) {
+    result += degree(u);
+  }
+  return result / 2;
+}
+
+const std::vector<Vertex> &IntervalGraph::vertices() const { return verts; }
+
+const Vertex &IntervalGraph::vertex(Id u) const { return verts[u]; }
+
+std::optional<Id> IntervalGraph::id_of(const Vertex &v) const {
+  auto it = std::lower_bound(verts.begin(), verts.end(), v);
+  if (it == verts.end() || *it != v)
+    return {};
+  return it - verts.begin();
+}
+
+bool IntervalGraph::adjacent(Id u, Id v) const {
+  return u != v && verts[u].intersects(verts[v]);
+}
+
+size_t IntervalGraph::degree(Id u) const {
+  // Intervals meeting u are those starting no later than u ends, less those
+  // ending before u starts (which necessarily also start before u ends)
+  const Vertex &vu = verts[u];
+  size_t starts = std::upper_bound(lowers.begin(), lowers.end(), vu.upper) -
+                  lowers.begin();
+  size_t ends = interval::first_upper_at_least(verts, vu.lower);
+  return starts - ends - 1;
+}
+
+std::vector<size_t> IntervalGraph::degrees() const {
+  std::vector<size_t> result(verts.size());
+  for (Id u = 0; u < verts.size(); ++u) {
+    result[u] = degree(u);
+  }
+  return result;
+}
+
+std::vector<Id> IntervalGraph::neighbours(Id u) const {
+  std::vector<Id> result;
+  find_neighbour(u, [&result](Id v) {
+    result.push_back(v);
+    return false;
+  });
+  return result;
+}
+
+bool IntervalGraph::is_connected() const {
+  // There is a gap after the k intervals with least right endpoints exactly
+  // when they all end before the (k+1)th left endpoint
+  for (size_t k = 1; k < verts.size(); ++k) {
+    if (verts[k - 1].upper < lowers[k])
+      return false;
+  }
+  return true;
+}
+
+Graph IntervalGraph::to_graph() const {
+  return Graph::interval_graph_from_set(
+      std::set<Vertex>(verts.begin(), verts.end()));
+}
+
+} // namespace interval_mist::graph
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "graph.hpp"
+#include "interval.hpp"
+#include "lower_tree.hpp"
+
+#include <optional>
+#include <set>
+#include <span>
+#include <vector>
+
+namespace interval_mist::graph {
+
+// Interval graph represented implicitly by its sorted endpoints. The edge set
+// is never materialized: adjacency, degree and neighbour queries are answered
+// by binary search and a min-tree over left endpoints, so memory is O(n).
+// Vertices are identified by their index in the canonical (right endpoint)
+// order of the intervals.
+struct IntervalGraph {
+  using Vertex = interval_mist::interval::Interval;
+  using Coord = Vertex::Coord;
+  using Id = uint32_t;
+
+  IntervalGraph(std::set<Vertex>);
+
+  IntervalGraph(std::vector<Vertex>);
+
+  // Replaces the vertices with vs, which must be distinct and in canonical
+  // order, rebuilding the index in the storage already held
+  void assign(std::span<const Vertex> vs);
+
+  size_t num_verts() const;
+
+  size_t num_edges() const;
+
+  const std::vector<Vertex> &vertices() const;
+
+  const Vertex &vertex(Id) const;
+
+  std::optional<Id> id_of(const Vertex &) const;
+
+  bool adjacent(Id, Id) const;
+
+  size_t degree(Id) const;
+
+  // Degree of every vertex in canonical order, in O(n log n) without listing
+  // any edges, so that the size of an explicit graph is known before building
+  // it
+  std::vector<size_t> degrees() const;
+
+  // Neighbours of u in canonical order
+  std::vector<Id> neighbours(Id u) const;
+
+  // First neighbour of u in canonical order satisfying pred, if any
+  // Costs O(log n) per neighbour visited
+  template <typename Pred>
+  std::optional<Id> find_neighbour(Id u, Pred pred) const {
+    const Vertex &vu = verts[u];
+    for (size_t v = interval::first_upper_at_least(verts, vu.lower);
+         (v = lower_tree.first_at_most(v, vu.upper)) < verts.size(); ++v) {
+      if (v != u && pred(static_cast<Id>(v)))
+        return static_cast<Id>(v);
+    }
+    return {};
+  }
+
+  bool is_connected() const;
+
+  Graph to_graph() const;
+
+private:
+  // Vertices in canonical order, so right endpoints are nondecreasing
+  std::vector<Vertex> verts;
+  // Left endpoints in sorted order
+  std::vector<Coord> lowers;
+  // Left endpoints of verts, for finding the next vertex starting by a point
+  interval::LowerTree lower_tree;
+
+  void build_index();
+};
+
+} // namespace interval_mist::graph
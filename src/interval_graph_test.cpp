@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+
+#include "interval_graph.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <random>
+
+namespace interval_mist::graph {
+
+using Vertex = IntervalGraph::Vertex;
+using Id = IntervalGraph::Id;
+
+TEST(IntervalGraphTest, Empty) {
+  IntervalGraph g = IntervalGraph(std::set<Vertex>());
+  EXPECT_EQ(0, g.num_verts());
+  EXPECT_EQ(0, g.num_edges());
+  EXPECT_TRUE(g.is_connected());
+}
+
+TEST(IntervalGraphTest, SimpleTree) {
+  // ___ ___ _________
+  //  _________ ___ ___
+  std::vector<Vertex> vs = {
+    Vertex(9, 11),
+    Vertex(0, 2),
+    Vertex(1, 6),
+    Vertex(3, 4),
+    Vertex(5, 10),
+    Vertex(7, 8),
+    Vertex(0, 2),
+  };
+  IntervalGraph g = IntervalGraph(vs);
+  ASSERT_EQ(6, g.num_verts());
+  EXPECT_EQ(Vertex(0, 2), g.vertex(0));
+  EXPECT_EQ(Vertex(9, 11), g.vertex(5));
+  EXPECT_EQ(std::optional<Id>(4), g.id_of(Vertex(5, 10)));
+  EXPECT_EQ(std::nullopt, g.id_of(Vertex(5, 9)));
+  EXPECT_EQ(std::vector<Id>({2}), g.neighbours(0));
+  EXPECT_EQ(std::vector<Id>({0, 1, 4}), g.neighbours(2));
+  EXPECT_EQ(std::vector<Id>({2, 3, 5}), g.neighbours(4));
+  EXPECT_EQ(3, g.degree(4));
+  EXPECT_TRUE(g.adjacent(2, 4));
+  EXPECT_FALSE(g.adjacent(0, 4));
+  EXPECT_FALSE(g.adjacent(4, 4));
+  EXPECT_EQ(5, g.num_edges());
+  EXPECT_TRUE(g.is_connected());
+}
+
+TEST(IntervalGraphTest, Disconnected) {
+  IntervalGraph g = IntervalGraph(std::set<Vertex>{
+    Vertex(0, 4),
+    Vertex(1, 2),
+    Vertex(5, 6),
+  });
+  EXPECT_FALSE(g.is_connected());
+  EXPECT_EQ(1, g.num_edges());
+}
+
+TEST(IntervalGraphTest, MatchesExplicitGraph) {
+  for (size_t seed = 0; seed < 20; ++seed) {
+    auto vs = interval::random_connected_interval_set(seed, 40);
+    IntervalGraph g = IntervalGraph(vs);
+    Graph expected = Graph::interval_graph_from_set(vs);
+    EXPECT_EQ(expected, g.to_graph());
+    EXPECT_EQ(expected.edges.size(), g.num_edges());
+    auto degrees = g.degrees();
+    ASSERT_EQ(g.num_verts(), degrees.size());
+    EXPECT_EQ(2 * g.num_edges(),
+              std::accumulate(degrees.begin(), degrees.end(), size_t(0)));
+    EXPECT_TRUE(g.is_connected());
+    for (Id u = 0; u < g.num_verts(); ++u) {
+      std::vector<Id> neighbours = g.neighbours(u);
+      EXPECT_EQ(neighbours.size(), g.degree(u));
+      EXPECT_EQ(neighbours.size(), degrees[u]);
+      for (Id v = 0; v < g.num_verts(); ++v) {
+        bool listed = std::count(neighbours.begin(), neighbours.end(), v);
+        EXPECT_EQ(g.adjacent(u, v), listed);
+        EXPECT_EQ(g.adjacent(u, v),
+                  expected.edges.count(Graph::Edge(g.vertex(u), g.vertex(v))) > 0);
+      }
+    }
+  }
+}
+
+TEST(IntervalGraphTest, FromSetMatchesPairwise) {
+  // Shared and touching endpoints, and intervals closing out of the order
+  // they opened in, on sets dense enough that many are open at once
+  for (size_t seed = 0; seed < 20; ++seed) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<Vertex::Coord> coord(0, 30);
+    std::set<Vertex> vs;
+    while (vs.size() < 40) {
+      Vertex::Coord x = coord(gen), y = coord(gen);
+      vs.insert(Vertex(std::min(x, y), std::max(x, y)));
+    }
+    std::set<Graph::Edge> es;
+    for (auto u = vs.begin(); u != vs.end(); ++u) {
+      for (auto v = std::next(u); v != vs.end(); ++v) {
+        if (u->intersects(*v))
+          es.insert(Graph::Edge(*u, *v));
+      }
+    }
+    EXPECT_EQ(Graph(vs, es), Graph::interval_graph_from_set(vs));
+  }
+}
+
+} // namespace interval_mist::graph
@@ -0,0 +1,245 @@
+#include "binary.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <fcntl.h>
+#include <fstream>
+#include <functional>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+namespace interval_mist::io::binary {
+
+static_assert(std::endian::native == std::endian::little);
+
+using Coord = Interval::Coord;
+using Vertex = Graph::Vertex;
+using Edge = Graph::Edge;
+
+std::optional<MappedFile> MappedFile::open(const std::string &path) {
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    return {};
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size == 0) {
+    close(fd);
+    return {};
+  }
+  size_t size = st.st_size;
+  void *data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping keeps its own reference to the file
+  close(fd);
+  if (data == MAP_FAILED)
+    return {};
+
+  // Start reading ahead, as solvers touch every page
+  madvise(data, size, MADV_WILLNEED);
+  return MappedFile(static_cast<const std::byte *>(data), size);
+}
+
+MappedFile::MappedFile(const std::byte *data, size_t size)
+    : data(data), size(size) {}
+
+MappedFile::MappedFile(MappedFile &&rhs)
+    : data(std::exchange(rhs.data, nullptr)),
+      size(std::exchange(rhs.size, 0)) {}
+
+MappedFile &MappedFile::operator=(MappedFile &&rhs) {
+  std::swap(data, rhs.data);
+  std::swap(size, rhs.size);
+  return *this;
+}
+
+MappedFile::~MappedFile() {
+  if (data)
+    munmap(const_cast<std::byte *>(data), size);
+}
+
+std::span<const std::byte> MappedFile::bytes() const { return {data, size}; }
+
+Graph MappedTree::to_graph() const {
+  std::set<Vertex> vs;
+  std::set<Edge> es;
+  for (size_t i = 0; i < intervals.size(); ++i) {
+    vs.insert(vs.end(), intervals[i]);
+    if (parent[i] != no_parent)
+      es.insert(Edge(intervals[i], intervals[parent[i]]));
+  }
+  return Graph(vs, es);
+}
+
+// Writes the header and endpoint arrays, leaving the stream open for more
+static void write_prefix(std::ofstream &out, Kind kind,
+                         std::span<const Interval> is) {
+  Header header{
+      .magic = magic,
+      .version = version,
+      .kind = kind,
+      .count = is.size(),
+  };
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+  // Gather each array through a buffer rather than one write per endpoint
+  constexpr size_t chunk = 1 << 16;
+  std::vector<Coord> buffer;
+  for (Coord Interval::*end : {&Interval::lower, &Interval::upper}) {
+    for (size_t begin = 0; begin < is.size(); begin += chunk) {
+      buffer.clear();
+      for (size_t i = begin; i < std::min(begin + chunk, is.size()); ++i) {
+        buffer.push_back(is[i].*end);
+      }
+      out.write(reinterpret_cast<const char *>(buffer.data()),
+                buffer.size() * sizeof(Coord));
+    }
+  }
+}
+
+bool write_intervals(const std::string &path, std::span<const Interval> is) {
+  if (std::adjacent_find(is.begin(), is.end(),
+                         std::greater_equal<Interval>()) != is.end())
+    return false;
+
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  write_prefix(out, Kind::intervals, is);
+  return out.good();
+}
+
+bool write_tree(const std::string &path, const Graph &tree) {
+  if (tree.edges.size() + 1 != tree.verts.size() && !tree.verts.empty())
+    return false;
+
+  std::vector<Vertex> is(tree.verts.begin(), tree.verts.end());
+  auto index = [&is](Vertex v) {
+    return std::lower_bound(is.begin(), is.end(), v) - is.begin();
+  };
+  std::vector<std::vector<uint32_t>> adj(is.size());
+  for (Edge e : tree.edges) {
+    adj[index(e.src)].push_back(index(e.dst));
+    adj[index(e.dst)].push_back(index(e.src));
+  }
+
+  // Orient edges away from the first vertex by depth first search
+  std::vector<uint32_t> parent(is.size(), no_parent);
+  std::vector<bool> seen(is.size());
+  std::vector<uint32_t> stack;
+  if (!is.empty()) {
+    stack.push_back(0);
+    seen[0] = true;
+  }
+  size_t num_seen = stack.size();
+  while (!stack.empty()) {
+    uint32_t u = stack.back();
+    stack.pop_back();
+    for (uint32_t v : adj[u]) {
+      if (seen[v])
+        continue;
+      seen[v] = true;
+      ++num_seen;
+      parent[v] = u;
+      stack.push_back(v);
+    }
+  }
+  if (num_seen != is.size())
+    return false;
+
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  write_prefix(out, Kind::tree, is);
+  out.write(reinterpret_cast<const char *>(parent.data()),
+            parent.size() * sizeof(uint32_t));
+  return out.good();
+}
+
+bool write_tree(const std::string &path, const SpanningTree &tree) {
+  if (tree.num_verts() != 0 && !tree.is_valid())
+    return false;
+
+  static_assert(SpanningTree::no_parent == no_parent);
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  write_prefix(out, Kind::tree, tree.vertices());
+  out.write(reinterpret_cast<const char *>(tree.parents().data()),
+            tree.parents().size() * sizeof(uint32_t));
+  return out.good();
+}
+
+using Arrays = std::vector<std::span<const uint32_t>>;
+
+// Maps a file and checks its header, returning its num_arrays arrays
+static std::optional<std::pair<MappedFile, Arrays>>
+map_arrays(const std::string &path, Kind kind, size_t num_arrays) {
+  auto file = MappedFile::open(path);
+  if (!file)
+    return {};
+  auto bytes = file->bytes();
+  if (bytes.size() < sizeof(Header))
+    return {};
+
+  Header header;
+  std::copy_n(bytes.data(), sizeof(Header),
+              reinterpret_cast<std::byte *>(&header));
+  if (header.magic != magic || header.version != version ||
+      header.kind != kind)
+    return {};
+  if (header.count > (bytes.size() - sizeof(Header)) / 4 / num_arrays ||
+      bytes.size() != sizeof(Header) + num_arrays * 4 * header.count)
+    return {};
+
+  // Mappings are page aligned, so arrays after the header are 4 byte aligned
+  auto words =
+      reinterpret_cast<const uint32_t *>(bytes.data() + sizeof(Header));
+  Arrays arrays;
+  for (size_t k = 0; k < num_arrays; ++k) {
+    arrays.emplace_back(words + k * header.count, header.count);
+  }
+  return std::pair(std::move(file.value()), std::move(arrays));
+}
+
+// Whether every interval is nonempty and each is after the last in canonical
+// order, which solvers assume of their input
+static bool is_canonical(std::span<const uint32_t> lower,
+                         std::span<const uint32_t> upper) {
+  for (size_t i = 0; i < lower.size(); ++i) {
+    if (lower[i] > upper[i])
+      return false;
+    if (i > 0 && std::pair(upper[i - 1], lower[i - 1]) >=
+                     std::pair(upper[i], lower[i]))
+      return false;
+  }
+  return true;
+}
+
+std::optional<MappedIntervals> read_intervals(const std::string &path) {
+  auto mapped = map_arrays(path, Kind::intervals, 2);
+  if (!mapped)
+    return {};
+  auto &[file, arrays] = mapped.value();
+  if (!is_canonical(arrays[0], arrays[1]))
+    return {};
+  return MappedIntervals{
+      .file = std::move(file),
+      .intervals = {.lower = arrays[0], .upper = arrays[1]},
+  };
+}
+
+std::optional<MappedTree> read_tree(const std::string &path) {
+  auto mapped = map_arrays(path, Kind::tree, 3);
+  if (!mapped)
+    return {};
+  auto &[file, arrays] = mapped.value();
+  // Parents are used as indices, so one out of range would read past the file
+  size_t count = arrays[2].size();
+  for (uint32_t p : arrays[2]) {
+    if (p >= count && p != no_parent)
+      return {};
+  }
+  return MappedTree{
+      .file = std::move(file),
+      .intervals = {.lower = arrays[0], .upper = arrays[1]},
+      .parent = arrays[2],
+  };
+}
+
+} // namespace interval_mist::io::binary
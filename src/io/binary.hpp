@@ -0,0 +1,105 @@
+#pragma once
+
+#include "../graph.hpp"
+#include "../interval.hpp"
+#include "../spanning_tree.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+
+namespace interval_mist::io::binary {
+
+using Graph = interval_mist::graph::Graph;
+using Interval = interval_mist::interval::Interval;
+using IntervalArrays = interval_mist::interval::IntervalArrays;
+using SpanningTree = interval_mist::graph::SpanningTree;
+
+// On disk format, in native (little endian) byte order:
+// - Header, 16 bytes
+// - lower: count uint32_t left endpoints
+// - upper: count uint32_t right endpoints
+// - parent: for trees only, count uint32_t indices into the arrays above, with
+//   no_parent at the root
+// Every array starts 4 byte aligned, so each can be used in place once the
+// file is mapped. Intervals are distinct and in canonical order, so solvers
+// can take them as they are.
+
+constexpr uint32_t magic = 0x5453494d; // "MIST"
+constexpr uint16_t version = 1;
+constexpr uint32_t no_parent = UINT32_MAX;
+
+enum class Kind : uint16_t {
+  intervals = 1,
+  tree = 2,
+};
+
+struct Header {
+  uint32_t magic;
+  uint16_t version;
+  Kind kind;
+  uint64_t count;
+};
+
+static_assert(sizeof(Header) == 16);
+
+// Read-only mapping of a whole file, unmapped on destruction
+struct MappedFile {
+  static std::optional<MappedFile> open(const std::string &path);
+
+  MappedFile(MappedFile &&rhs);
+  MappedFile &operator=(MappedFile &&rhs);
+  ~MappedFile();
+
+  std::span<const std::byte> bytes() const;
+
+private:
+  const std::byte *data = nullptr;
+  size_t size = 0;
+
+  MappedFile(const std::byte *data, size_t size);
+};
+
+// Intervals read in place from a mapped file, valid while it lives
+struct MappedIntervals {
+  MappedFile file;
+  IntervalArrays intervals;
+};
+
+// Spanning tree read in place from a mapped file, valid while it lives
+struct MappedTree {
+  MappedFile file;
+  IntervalArrays intervals;
+  std::span<const uint32_t> parent;
+
+  Graph to_graph() const;
+};
+
+// Writers return false if the file could not be written
+
+// Also returns false if is is not distinct and in canonical order
+bool write_intervals(const std::string &path, std::span<const Interval> is);
+
+// Stores the tree's vertices in canonical order, with parents towards the
+// first. Also returns false if tree is not a tree.
+bool write_tree(const std::string &path, const Graph &tree);
+
+// Stores the tree's own parent array as it is, without reorienting it. Also
+// returns false if tree is not valid.
+bool write_tree(const std::string &path, const SpanningTree &tree);
+
+// Readers check the header and file size, but not the contents, which are
+// only paged in as they are used. They return nothing if the file cannot be
+// mapped or is not of the expected kind and version.
+
+// Also reads every interval, returning nothing if one has lower > upper or
+// they are not distinct and in canonical order
+std::optional<MappedIntervals> read_intervals(const std::string &path);
+
+// Also reads every parent, returning nothing if one is neither an index into
+// the arrays nor no_parent
+std::optional<MappedTree> read_tree(const std::string &path);
+
+} // namespace interval_mist::io::binary
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+
+#include "binary.hpp"
+
+#include <fstream>
+#include <vector>
+
+namespace interval_mist::io::binary {
+
+using Vertex = Graph::Vertex;
+using Edge = Graph::Edge;
+
+static std::string temp_path(const std::string &name) {
+  return testing::TempDir() + "/" + name;
+}
+
+TEST(BinaryTest, IntervalsRoundTrip) {
+  auto is = interval::random_connected_intervals(3, 100000);
+  auto path = temp_path("intervals.bin");
+  ASSERT_TRUE(write_intervals(path, is));
+
+  auto mapped = read_intervals(path);
+  ASSERT_TRUE(mapped.has_value());
+  ASSERT_EQ(is.size(), mapped->intervals.size());
+  for (size_t i = 0; i < is.size(); ++i) {
+    ASSERT_EQ(is[i], mapped->intervals[i]);
+  }
+}
+
+TEST(BinaryTest, Empty) {
+  auto path = temp_path("empty.bin");
+  ASSERT_TRUE(write_intervals(path, {}));
+  auto mapped = read_intervals(path);
+  ASSERT_TRUE(mapped.has_value());
+  EXPECT_EQ(0, mapped->intervals.size());
+}
+
+TEST(BinaryTest, IntervalsMustBeCanonical) {
+  auto path = temp_path("not_canonical.bin");
+  EXPECT_FALSE(write_intervals(path, std::vector{Vertex(0, 6), Vertex(1, 5)}));
+  EXPECT_FALSE(write_intervals(path, std::vector{Vertex(0, 2), Vertex(0, 2)}));
+}
+
+TEST(BinaryTest, RejectsIntervalsNotCanonical) {
+  auto is = std::vector{Vertex(0, 2), Vertex(1, 5), Vertex(3, 6)};
+  auto path = temp_path("bad_intervals.bin");
+
+  // Words to overwrite after the header, by index into lower then upper:
+  // making an interval empty, out of order, or equal to its predecessor
+  using Words = std::vector<std::pair<size_t, uint32_t>>;
+  for (const Words &words : {Words{{1, 6}}, Words{{4, 7}},
+                             Words{{2, 1}, {5, 5}}}) {
+    ASSERT_TRUE(write_intervals(path, is));
+    {
+      std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+      for (auto [index, word] : words) {
+        file.seekp(sizeof(Header) + index * sizeof(uint32_t));
+        file.write(reinterpret_cast<const char *>(&word), sizeof(word));
+      }
+    }
+    EXPECT_FALSE(read_intervals(path).has_value()) << words.front().first;
+  }
+}
+
+TEST(BinaryTest, TreeRoundTrip) {
+  Vertex a = Vertex(0, 2), b = Vertex(1, 5), c = Vertex(3, 4),
+         d = Vertex(4, 7);
+  Graph tree({a, b, c, d}, {Edge(a, b), Edge(b, c), Edge(b, d)});
+  auto path = temp_path("tree.bin");
+  ASSERT_TRUE(write_tree(path, tree));
+
+  auto mapped = read_tree(path);
+  ASSERT_TRUE(mapped.has_value());
+  EXPECT_EQ(std::vector<uint32_t>({no_parent, 2, 0, 2}),
+            std::vector<uint32_t>(mapped->parent.begin(),
+                                  mapped->parent.end()));
+  EXPECT_EQ(tree.verts, mapped->to_graph().verts);
+  EXPECT_EQ(tree.edges, mapped->to_graph().edges);
+}
+
+TEST(BinaryTest, RejectsParentOutOfRange) {
+  Vertex a = Vertex(0, 2), b = Vertex(1, 5), c = Vertex(3, 4);
+  Graph tree({a, b, c}, {Edge(a, b), Edge(b, c)});
+  auto path = temp_path("bad_parent.bin");
+  ASSERT_TRUE(write_tree(path, tree));
+
+  // Overwrite the parent of the last vertex, after the header and endpoints
+  for (uint32_t parent : {uint32_t(3), no_parent - 1}) {
+    {
+      std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+      file.seekp(sizeof(Header) + 3 * 2 * sizeof(uint32_t) +
+                 2 * sizeof(uint32_t));
+      file.write(reinterpret_cast<const char *>(&parent), sizeof(parent));
+    }
+    EXPECT_FALSE(read_tree(path).has_value()) << parent;
+  }
+}
+
+TEST(BinaryTest, NotTree) {
+  Vertex a = Vertex(0, 2), b = Vertex(1, 5), c = Vertex(4, 7);
+  auto path = temp_path("not_tree.bin");
+  EXPECT_FALSE(write_tree(path, Graph({a, b, c}, {Edge(a, b)})));
+  EXPECT_FALSE(write_tree(
+      path, Graph({a, b, c}, {Edge(a, b), Edge(b, c), Edge(a, c)})));
+}
+
+TEST(BinaryTest, RejectsBadFiles) {
+  EXPECT_FALSE(read_intervals(temp_path("missing.bin")).has_value());
+
+  auto is = interval::random_connected_intervals(3, 10);
+  auto path = temp_path("kind.bin");
+  ASSERT_TRUE(write_intervals(path, is));
+  EXPECT_FALSE(read_tree(path).has_value());
+
+  // Truncated arrays
+  auto truncated = temp_path("truncated.bin");
+  {
+    std::ifstream in(path, std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(in)), {});
+    std::ofstream out(truncated, std::ios::binary);
+    out.write(bytes.data(), bytes.size() - 4);
+  }
+  EXPECT_FALSE(read_intervals(truncated).has_value());
+
+  auto garbage = temp_path("garbage.bin");
+  {
+    std::ofstream out(garbage, std::ios::binary);
+    out << "not an interval file at all";
+  }
+  EXPECT_FALSE(read_intervals(garbage).has_value());
+}
+
+} // namespace interval_mist::io::binary
@@ -0,0 +1,129 @@
+#include "text.hpp"
+
+#include <array>
+#include <charconv>
+#include <iterator>
+#include <string>
+
+namespace interval_mist::io::text {
+
+using Coord = Interval::Coord;
+
+// Calls add(first, second) for each line's pair of numbers, failing if any
+// line is malformed or add returns false
+template <typename T, typename F>
+static bool read_pairs(std::istream &is, F add) {
+  // Parse from one buffer, as stream extraction is far slower at scale
+  std::string buffer(std::istreambuf_iterator<char>(is), {});
+  const char *p = buffer.data(), *end = p + buffer.size();
+
+  auto skip_spaces = [&]() {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r'))
+      ++p;
+  };
+  auto parse = [&](T &c) {
+    skip_spaces();
+    auto [next, ec] = std::from_chars(p, end, c);
+    p = next;
+    return ec == std::errc();
+  };
+
+  while (p < end) {
+    skip_spaces();
+    if (p < end && *p == '#') {
+      while (p < end && *p != '\n')
+        ++p;
+    } else if (p < end && *p != '\n') {
+      T first, second;
+      if (!parse(first) || !parse(second) || !add(first, second))
+        return false;
+      skip_spaces();
+      if (p < end && *p != '\n')
+        return false;
+    }
+    // Past the end of the line
+    ++p;
+  }
+  return true;
+}
+
+std::optional<std::vector<Interval>> read_intervals(std::istream &is) {
+  std::vector<Interval> result;
+  bool ok = read_pairs<Coord>(is, [&result](Coord lower, Coord upper) {
+    if (lower > upper)
+      return false;
+    result.emplace_back(lower, upper);
+    return true;
+  });
+  if (!ok)
+    return {};
+  return result;
+}
+
+template <typename T>
+std::optional<std::vector<compress::Raw<T>>>
+read_raw_intervals(std::istream &is) {
+  std::vector<compress::Raw<T>> result;
+  bool ok = read_pairs<T>(is, [&result](T lower, T upper) {
+    result.push_back({lower, upper});
+    return true;
+  });
+  if (!ok)
+    return {};
+  return result;
+}
+
+template std::optional<std::vector<compress::Raw<int64_t>>>
+read_raw_intervals(std::istream &);
+
+template std::optional<std::vector<compress::Raw<double>>>
+read_raw_intervals(std::istream &);
+
+void write_tree(std::ostream &os, const Graph &tree) {
+  for (auto e : tree.edges) {
+    os << e.src.lower << ' ' << e.src.upper << ' ' << e.dst.lower << ' '
+       << e.dst.upper << '\n';
+  }
+}
+
+void write_tree(std::ostream &os, const SpanningTree &tree) {
+  for (SpanningTree::Id u = 0; u < tree.num_verts(); ++u) {
+    if (tree.parent(u) == SpanningTree::no_parent)
+      continue;
+    const auto &src = tree.vertex(u), &dst = tree.vertex(tree.parent(u));
+    os << src.lower << ' ' << src.upper << ' ' << dst.lower << ' ' << dst.upper
+       << '\n';
+  }
+}
+
+// Shortest text that reads back as v
+template <typename T> static void write_value(std::ostream &os, T v) {
+  std::array<char, 32> buffer;
+  auto [end, ec] = std::to_chars(buffer.begin(), buffer.end(), v);
+  os.write(buffer.data(), end - buffer.data());
+}
+
+template <typename T>
+void write_tree(std::ostream &os, const SpanningTree &tree,
+                std::span<const T> values) {
+  for (SpanningTree::Id u = 0; u < tree.num_verts(); ++u) {
+    if (tree.parent(u) == SpanningTree::no_parent)
+      continue;
+    const auto &src = tree.vertex(u), &dst = tree.vertex(tree.parent(u));
+    std::array<Coord, 4> cs = {src.lower, src.upper, dst.lower, dst.upper};
+    for (size_t k = 0; k < cs.size(); ++k) {
+      if (k > 0)
+        os << ' ';
+      write_value(os, values[cs[k]]);
+    }
+    os << '\n';
+  }
+}
+
+template void write_tree(std::ostream &, const SpanningTree &,
+                         std::span<const int64_t>);
+
+template void write_tree(std::ostream &, const SpanningTree &,
+                         std::span<const double>);
+
+} // namespace interval_mist::io::text
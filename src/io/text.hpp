@@ -0,0 +1,46 @@
+#pragma once
+
+#include "../compress.hpp"
+#include "../graph.hpp"
+#include "../interval.hpp"
+#include "../spanning_tree.hpp"
+
+#include <cstdint>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <vector>
+
+namespace interval_mist::io::text {
+
+using Graph = interval_mist::graph::Graph;
+using Interval = interval_mist::interval::Interval;
+using SpanningTree = interval_mist::graph::SpanningTree;
+
+// Plain text format, one record per line with fields separated by spaces:
+// - intervals: "lower upper"
+// - trees: "lower upper lower upper" per edge
+// Blank lines and lines starting with '#' are ignored.
+
+// Intervals in the order given, or nothing if any line is malformed
+std::optional<std::vector<Interval>> read_intervals(std::istream &is);
+
+// As above, with endpoints of any value of type T (int64_t or double), for
+// compress::compress to check and map onto coordinates
+template <typename T>
+std::optional<std::vector<compress::Raw<T>>>
+read_raw_intervals(std::istream &is);
+
+void write_tree(std::ostream &os, const Graph &tree);
+
+// Edges from each vertex to its parent, in canonical order of the child
+void write_tree(std::ostream &os, const SpanningTree &tree);
+
+// As above, writing each coordinate c as values[c], such as the original
+// endpoints kept by compress::compress. Defined for int64_t and double.
+template <typename T>
+void write_tree(std::ostream &os, const SpanningTree &tree,
+                std::span<const T> values);
+
+} // namespace interval_mist::io::text
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include "text.hpp"
+
+#include <cmath>
+#include <sstream>
+
+namespace interval_mist::io::text {
+
+using Vertex = Graph::Vertex;
+using Edge = Graph::Edge;
+
+static std::optional<std::vector<Interval>> read(const std::string &s) {
+  std::istringstream is(s);
+  return read_intervals(is);
+}
+
+TEST(TextTest, ReadIntervals) {
+  EXPECT_EQ(std::vector<Interval>({Interval(0, 2), Interval(1, 5)}),
+            read("0 2\n1 5\n"));
+  EXPECT_EQ(std::vector<Interval>({Interval(3, 4), Interval(0, 2)}),
+            read("# comment\n\n  3\t4  \r\n0 2"));
+  EXPECT_EQ(std::vector<Interval>(), read(""));
+}
+
+TEST(TextTest, RejectsMalformed) {
+  EXPECT_FALSE(read("0\n").has_value());
+  EXPECT_FALSE(read("0 2 3\n").has_value());
+  EXPECT_FALSE(read("5 2\n").has_value());
+  EXPECT_FALSE(read("a b\n").has_value());
+  EXPECT_FALSE(read("-1 2\n").has_value());
+}
+
+TEST(TextTest, WriteTree) {
+  Vertex a = Vertex(0, 2), b = Vertex(1, 5), c = Vertex(4, 7);
+  std::ostringstream os;
+  write_tree(os, Graph({a, b, c}, {Edge(a, b), Edge(b, c)}));
+  EXPECT_EQ("0 2 1 5\n1 5 4 7\n", os.str());
+}
+
+TEST(TextTest, ReadRawIntervals) {
+  std::istringstream ints("-5 1700000000000\n# comment\n3 -2\n");
+  EXPECT_EQ(std::vector<compress::Raw<int64_t>>(
+                {{-5, 1'700'000'000'000}, {3, -2}}),
+            read_raw_intervals<int64_t>(ints));
+
+  std::istringstream floats("0.5 1e3\n-2 inf\n");
+  EXPECT_EQ(std::vector<compress::Raw<double>>(
+                {{0.5, 1000}, {-2, INFINITY}}),
+            read_raw_intervals<double>(floats));
+
+  std::istringstream bad("1.5 2\n");
+  EXPECT_FALSE(read_raw_intervals<int64_t>(bad).has_value());
+}
+
+TEST(TextTest, WriteTreeInOriginalValues) {
+  std::vector<compress::Raw<double>> raw = {{-1.25, 0.1}, {0.1, 3e10}};
+  auto c = compress::compress<double>(raw);
+  SpanningTree tree(c->intervals);
+  tree.add_edge(0, 1);
+  std::ostringstream os;
+  write_tree(os, tree, std::span<const double>(c->values));
+  EXPECT_EQ("0.1 3e+10 -1.25 0.1\n", os.str());
+}
+
+} // namespace interval_mist::io::text
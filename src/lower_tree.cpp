@@ -0,0 +1,113 @@
+#include "lower_tree.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+namespace interval_mist::interval {
+
+using Coord = LowerTree::Coord;
+
+static constexpr Coord absent = std::numeric_limits<Coord>::max();
+
+static size_t leaves_for(size_t n) {
+  size_t size = 1;
+  while (size < n) {
+    size <<= 1;
+  }
+  return size;
+}
+
+LowerTree::LowerTree(size_t n) : num(n), mins(2 * leaves_for(n), absent) {}
+
+LowerTree::LowerTree(std::span<const Interval> is) : LowerTree(0) {
+  assign(is);
+}
+
+LowerTree::LowerTree(const IntervalArrays &is)
+    : num(is.size()), mins(2 * leaves_for(is.size()), absent) {
+  size_t size = mins.size() / 2;
+  for (size_t i = 0; i < is.size(); ++i) {
+    assert(is.lower[i] != absent);
+    mins[size + i] = is.lower[i];
+  }
+  for (size_t i = size - 1; i > 0; --i) {
+    mins[i] = std::min(mins[2 * i], mins[2 * i + 1]);
+  }
+}
+
+void LowerTree::assign(std::span<const Interval> is) {
+  num = is.size();
+  mins.assign(2 * leaves_for(is.size()), absent);
+  size_t size = mins.size() / 2;
+  for (size_t i = 0; i < is.size(); ++i) {
+    assert(is[i].lower != absent);
+    mins[size + i] = is[i].lower;
+  }
+  for (size_t i = size - 1; i > 0; --i) {
+    mins[i] = std::min(mins[2 * i], mins[2 * i + 1]);
+  }
+}
+
+size_t LowerTree::size() const { return num; }
+
+bool LowerTree::contains(size_t i) const {
+  return mins[mins.size() / 2 + i] != absent;
+}
+
+void LowerTree::insert(size_t i, Coord lower) {
+  // The sentinel doubles as a left endpoint, so such intervals are unsupported
+  assert(lower != absent);
+  update(i, lower);
+}
+
+void LowerTree::erase(size_t i) { update(i, absent); }
+
+void LowerTree::update(size_t i, Coord lower) {
+  size_t node = mins.size() / 2 + i;
+  mins[node] = lower;
+  for (node >>= 1; node > 0; node >>= 1) {
+    mins[node] = std::min(mins[2 * node], mins[2 * node + 1]);
+  }
+}
+
+size_t LowerTree::first_at_most(size_t from, Coord c) const {
+  if (from >= num)
+    return num;
+  // Never match the sentinel marking absent positions
+  c = std::min(c, absent - 1);
+
+  // Walk right from the leaf until we reach a subtree containing a match
+  size_t size = mins.size() / 2;
+  size_t node = size + from;
+  while (mins[node] > c) {
+    while (node & 1) {
+      node >>= 1;
+    }
+    if (node == 0)
+      return num;
+    ++node;
+  }
+
+  // Descend to the leftmost matching leaf of that subtree
+  while (node < size) {
+    node <<= 1;
+    if (mins[node] > c)
+      ++node;
+  }
+  return std::min(node - size, num);
+}
+
+size_t first_upper_at_least(std::span<const Interval> is, Interval::Coord c) {
+  return std::partition_point(is.begin(), is.end(),
+                              [c](const Interval &v) { return v.upper < c; }) -
+         is.begin();
+}
+
+size_t first_upper_at_least(const IntervalArrays &is, Interval::Coord c) {
+  auto before = [c](Coord upper) { return upper < c; };
+  return std::partition_point(is.upper.begin(), is.upper.end(), before) -
+         is.upper.begin();
+}
+
+} // namespace interval_mist::interval
@@ -0,0 +1,208 @@
+#pragma once
+
+#include "interval.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace interval_mist::interval {
+
+// Segment tree over the left endpoints of a sequence of intervals (usually in
+// canonical order), answering "first interval at or after position i that
+// starts no later than c" in O(log n). Positions can be removed from and
+// restored to consideration, which lets sweeps track visited sets without
+// rescanning.
+struct LowerTree {
+  using Coord = Interval::Coord;
+
+  // Tree over n positions, none of which are present
+  LowerTree(size_t n);
+
+  // Tree over every interval in is, all present
+  LowerTree(std::span<const Interval> is);
+
+  LowerTree(const IntervalArrays &is);
+
+  // Replaces the tree with one over every interval in is, reusing its storage
+  void assign(std::span<const Interval> is);
+
+  size_t size() const;
+
+  bool contains(size_t i) const;
+
+  void insert(size_t i, Coord lower);
+
+  void erase(size_t i);
+
+  // First present position at or after from whose left endpoint is at most c,
+  // or size() if there is none
+  size_t first_at_most(size_t from, Coord c) const;
+
+private:
+  size_t num;
+  std::vector<Coord> mins;
+
+  void update(size_t i, Coord lower);
+};
+
+// First position in is, sorted by right endpoint, with upper >= c
+size_t first_upper_at_least(std::span<const Interval> is, Interval::Coord c);
+
+size_t first_upper_at_least(const IntervalArrays &is, Interval::Coord c);
+
+// Dynamic counterpart of LowerTree for when positions are not known in
+// advance: an ordered set of keys, each with a left endpoint, answering
+// "first key at or after k whose left endpoint is at most c" in O(log n)
+// expected time. Kept as a treap over a pool of nodes, so storage freed by
+// erased keys is reused.
+template <typename Key> struct LowerSet {
+  using Coord = Interval::Coord;
+
+  bool empty() const { return root == none; }
+
+  size_t size() const { return count; }
+
+  // Key must not already be present
+  void insert(const Key &key, Coord lower) {
+    size_t node = allocate(key, lower);
+    auto [left, right] = split(root, key);
+    root = merge(merge(left, node), right);
+    ++count;
+  }
+
+  // Key must be present
+  void erase(const Key &key) {
+    root = erase(root, key);
+    --count;
+  }
+
+  // First key at or after from whose left endpoint is at most c
+  std::optional<Key> first_at_most(const Key &from, Coord c) const {
+    size_t node = first_at_most(root, from, c);
+    if (node == none)
+      return {};
+    return nodes[node].key;
+  }
+
+  // Nodes visited by first_at_most so far, a measure of the work done
+  size_t num_visited() const { return visited; }
+
+private:
+  static constexpr size_t none = std::numeric_limits<size_t>::max();
+
+  struct Node {
+    Key key;
+    // Left endpoint of this key, and least over its subtree
+    Coord lower, min;
+    uint64_t priority;
+    size_t left, right;
+  };
+
+  std::vector<Node> nodes;
+  std::vector<size_t> unused;
+  size_t root = none;
+  size_t count = 0;
+  uint64_t seed = 0;
+  mutable size_t visited = 0;
+
+  // Priorities from a fixed sequence, so runs are reproducible
+  uint64_t next_priority() {
+    uint64_t x = seed += 0x9e3779b97f4a7c15;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111eb;
+    return x ^ (x >> 31);
+  }
+
+  size_t allocate(const Key &key, Coord lower) {
+    Node node{key, lower, lower, next_priority(), none, none};
+    if (unused.empty()) {
+      nodes.push_back(node);
+      return nodes.size() - 1;
+    }
+    size_t i = unused.back();
+    unused.pop_back();
+    nodes[i] = node;
+    return i;
+  }
+
+  Coord min_of(size_t node) const {
+    return node == none ? std::numeric_limits<Coord>::max() : nodes[node].min;
+  }
+
+  void update(size_t node) {
+    Node &n = nodes[node];
+    n.min = std::min({n.lower, min_of(n.left), min_of(n.right)});
+  }
+
+  // Subtrees of keys before key and keys at or after it
+  std::pair<size_t, size_t> split(size_t node, const Key &key) {
+    if (node == none)
+      return {none, none};
+    if (nodes[node].key < key) {
+      auto [left, right] = split(nodes[node].right, key);
+      nodes[node].right = left;
+      update(node);
+      return {node, right};
+    }
+    auto [left, right] = split(nodes[node].left, key);
+    nodes[node].left = right;
+    update(node);
+    return {left, node};
+  }
+
+  // Every key in left precedes every key in right
+  size_t merge(size_t left, size_t right) {
+    if (left == none)
+      return right;
+    if (right == none)
+      return left;
+    if (nodes[left].priority > nodes[right].priority) {
+      nodes[left].right = merge(nodes[left].right, right);
+      update(left);
+      return left;
+    }
+    nodes[right].left = merge(left, nodes[right].left);
+    update(right);
+    return right;
+  }
+
+  size_t erase(size_t node, const Key &key) {
+    assert(node != none);
+    Node &n = nodes[node];
+    if (key < n.key) {
+      n.left = erase(n.left, key);
+    } else if (n.key < key) {
+      n.right = erase(n.right, key);
+    } else {
+      unused.push_back(node);
+      return merge(n.left, n.right);
+    }
+    update(node);
+    return node;
+  }
+
+  // Subtrees whose least left endpoint is too large are skipped whole, so
+  // only the search path for from and one descent to the match are visited
+  size_t first_at_most(size_t node, const Key &from, Coord c) const {
+    if (min_of(node) > c)
+      return none;
+    ++visited;
+    const Node &n = nodes[node];
+    if (n.key < from)
+      return first_at_most(n.right, from, c);
+    size_t found = first_at_most(n.left, from, c);
+    if (found != none)
+      return found;
+    if (n.lower <= c)
+      return node;
+    return first_at_most(n.right, from, c);
+  }
+};
+
+} // namespace interval_mist::interval
@@ -2,16 +2,19 @@
 #include "graph/tree_transform.hpp"
 #include "interval.hpp"
 #include "solvers.hpp"
+#include "spanning_tree.hpp"
 #include "tester.hpp"
 
 #include <iostream>
 #include <random>
 #include <set>
+#include <vector>
 
 namespace interval_mist {
 
 using Interval = interval::Interval;
 using Graph = graph::Graph;
+using SpanningTree = graph::SpanningTree;
 using Vertex = Graph::Vertex;
 using Edge = Graph::Edge;
 
@@ -27,7 +30,8 @@ void fuzz_greedy_vs_naive() {
   auto result =
       tester::fuzz_compare_solvers(lhs, rhs, num_tests, seed, num_verts);
   if (result) {
-    result.value().report(std::cout, "GREEDY", "NAIVE");
+    tester::shrink(lhs, rhs, result.value())
+        .report(std::cout, "GREEDY", "NAIVE");
   }
 }
 
@@ -43,7 +47,71 @@ void fuzz_greedy_vs_dp() {
   auto result =
       tester::fuzz_compare_solvers(lhs, rhs, num_tests, seed, num_verts);
   if (result) {
-    result.value().report(std::cout, "GREEDY", "DP");
+    tester::shrink(lhs, rhs, result.value())
+        .report(std::cout, "GREEDY", "DP");
+  }
+}
+
+// Adapts the sorted greedy engine to the Graph based solver interface
+std::optional<SpanningTree> interval_mist_greedy_sorted(Graph g) {
+  std::vector<Interval> is(g.verts.begin(), g.verts.end());
+  return solvers::greedy::interval_mist_greedy_sorted(is);
+}
+
+void fuzz_sorted_greedy_vs_dp() {
+  std::cerr << "Fuzz testing sorted greedy solver vs dp" << std::endl;
+
+  tester::Solver lhs = interval_mist_greedy_sorted;
+  tester::Solver rhs = solvers::dp::interval_mist_dp;
+  size_t num_tests = 5000;
+  size_t seed = 283947130;
+  size_t num_verts = 16;
+
+  auto result =
+      tester::fuzz_compare_solvers(lhs, rhs, num_tests, seed, num_verts);
+  if (result) {
+    tester::shrink(lhs, rhs, result.value())
+        .report(std::cout, "SORTED GREEDY", "DP");
+  }
+}
+
+// Adapts the streaming greedy to the Graph based solver interface
+std::optional<SpanningTree> interval_mist_greedy_stream(Graph g) {
+  std::vector<Interval> is(g.verts.begin(), g.verts.end());
+  return solvers::greedy::interval_mist_greedy_stream(is);
+}
+
+void fuzz_stream_greedy_vs_dp() {
+  std::cerr << "Fuzz testing streaming greedy solver vs dp" << std::endl;
+
+  tester::Solver lhs = interval_mist_greedy_stream;
+  tester::Solver rhs = solvers::dp::interval_mist_dp;
+  size_t num_tests = 5000;
+  size_t seed = 283947130;
+  size_t num_verts = 16;
+
+  auto result =
+      tester::fuzz_compare_solvers(lhs, rhs, num_tests, seed, num_verts);
+  if (result) {
+    tester::shrink(lhs, rhs, result.value())
+        .report(std::cout, "STREAM GREEDY", "DP");
+  }
+}
+
+void fuzz_frontier_dp_vs_dp() {
+  std::cerr << "Fuzz testing frontier dp solver vs dp" << std::endl;
+
+  tester::Solver lhs = solvers::frontier_dp::interval_mist_frontier_dp;
+  tester::Solver rhs = solvers::dp::interval_mist_dp;
+  size_t num_tests = 5000;
+  size_t seed = 283947130;
+  size_t num_verts = 16;
+
+  auto result =
+      tester::fuzz_compare_solvers(lhs, rhs, num_tests, seed, num_verts);
+  if (result) {
+    tester::shrink(lhs, rhs, result.value())
+        .report(std::cout, "FRONTIER DP", "DP");
   }
 }
 
@@ -80,11 +148,10 @@ void validate_lre_leaf_transform() {
     auto g = Graph::random_connected_interval_graph(rng(), num_verts);
     auto maybe_mist = solvers::dp::interval_mist_dp(g);
     assert(maybe_mist.has_value());
-    auto orig_mist = maybe_mist.value();
+    auto orig_mist = maybe_mist.value().to_graph();
 
     // Early exit trivially if LRE is already leaf
-    auto lre = *g.verts.begin();
-    if (orig_mist.leaves().count(lre)) {
+    if (maybe_mist.value().degree(0) == 1) {
       ++trivial_passes;
       continue;
     }
@@ -109,6 +176,12 @@ int main() {
 
   // interval_mist::fuzz_greedy_vs_dp();
 
+  // interval_mist::fuzz_sorted_greedy_vs_dp();
+
+  // interval_mist::fuzz_stream_greedy_vs_dp();
+
+  // interval_mist::fuzz_frontier_dp_vs_dp();
+
   interval_mist::validate_lre_leaf_transform();
 
   return 0;
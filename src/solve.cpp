@@ -0,0 +1,459 @@
+#include "compact_graph.hpp"
+#include "compress.hpp"
+#include "cut_points.hpp"
+#include "forest.hpp"
+#include "graph.hpp"
+#include "interval.hpp"
+#include "interval_graph.hpp"
+#include "io/binary.hpp"
+#include "io/text.hpp"
+#include "solvers/registry.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <span>
+#include <string>
+#include <sys/resource.h>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+namespace interval_mist {
+
+using Interval = interval::Interval;
+using IntervalArrays = interval::IntervalArrays;
+using Graph = graph::Graph;
+using IntervalGraph = graph::IntervalGraph;
+using CompactGraph = graph::CompactGraph;
+using SpanningTree = graph::SpanningTree;
+
+namespace registry = solvers::registry;
+
+static const char *usage =
+    R"(Usage: solve [--solver NAME] [--tree PATH] [--forest | --cut-points]
+             [--compress int|float] [--list] [INPUT]
+
+Finds a spanning tree of the interval graph in INPUT with as few leaves as the
+solver manages, and writes a JSON summary to stdout.
+
+INPUT is a binary interval file (see io/binary.hpp) or text with one "lower
+upper" pair per line. With no INPUT or "-", text is read from stdin.
+
+  --solver NAME  Solver to run (default greedy_sorted)
+  --tree PATH    Also write the tree, in binary if PATH ends in .bin and as
+                 text otherwise
+  --forest       Solve each connected component separately, in parallel,
+                 giving a spanning forest. The tree is always written as text.
+  --cut-points   Split the input at intervals that alone cover some point, and
+                 solve the blocks between them separately, in parallel
+  --compress int|float
+                 Read INPUT as text with endpoints of any 64-bit integer or
+                 floating point value, mapping them onto coordinates
+                 0, 1, 2, ... before solving. The tree is written as text in
+                 the original values.
+  --list         List the solvers and exit
+
+Exits with 0 if a tree was found (for every component, with --forest), 1 if
+not, and 2 on bad usage or input.
+)";
+
+struct Options {
+  std::string solver = "greedy_sorted";
+  std::string input = "-";
+  std::optional<std::string> tree;
+  bool forest = false;
+  bool cut_points = false;
+  std::optional<std::string> compress;
+  bool list = false;
+};
+
+static std::optional<Options> parse_args(int argc, char **argv) {
+  Options options;
+  bool have_input = false;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg == "--list") {
+      options.list = true;
+    } else if (arg == "--forest") {
+      options.forest = true;
+    } else if (arg == "--cut-points") {
+      options.cut_points = true;
+    } else if ((arg == "--solver" || arg == "--tree") && i + 1 < argc) {
+      (arg == "--solver" ? options.solver : options.tree.emplace()) =
+          argv[++i];
+    } else if (arg == "--compress" && i + 1 < argc) {
+      options.compress = argv[++i];
+      if (options.compress != "int" && options.compress != "float")
+        return {};
+    } else if ((arg.empty() || arg[0] != '-' || arg == "-") && !have_input) {
+      options.input = arg;
+      have_input = true;
+    } else {
+      return {};
+    }
+  }
+  if (options.forest && options.cut_points)
+    return {};
+  if (options.compress && options.tree && options.tree->ends_with(".bin"))
+    return {};
+  return options;
+}
+
+// Original value of each coordinate, if the input was compressed
+using Values =
+    std::variant<std::monostate, std::vector<int64_t>, std::vector<double>>;
+
+struct Input {
+  // Distinct and in canonical order, unless mapped holds them instead
+  std::vector<Interval> intervals;
+  // A binary file, read in place
+  std::optional<io::binary::MappedIntervals> mapped;
+  Values values;
+
+  size_t size() const {
+    return mapped ? mapped->intervals.size() : intervals.size();
+  }
+
+  // Copies mapped intervals into intervals, for callers that need them whole
+  void unmap() {
+    if (!mapped)
+      return;
+    const IntervalArrays &is = mapped->intervals;
+    intervals.reserve(is.size());
+    for (size_t i = 0; i < is.size(); ++i) {
+      intervals.push_back(is[i]);
+    }
+    mapped.reset();
+  }
+};
+
+// Intervals of any value of type T from text, compressed onto coordinates
+template <typename T>
+static std::optional<Input> read_compressed(std::istream &is) {
+  auto raw = io::text::read_raw_intervals<T>(is);
+  if (!raw)
+    return {};
+  auto compressed = compress::compress<T>(raw.value());
+  if (!compressed)
+    return {};
+  return Input{std::move(compressed->intervals), {},
+               std::move(compressed->values)};
+}
+
+// Distinct intervals in canonical order, mapped in place from a binary file
+// if it is one, and read from text otherwise
+static std::optional<Input> read_intervals(const std::string &path) {
+  std::optional<std::vector<Interval>> text;
+  if (path == "-") {
+    text = io::text::read_intervals(std::cin);
+  } else if (auto mapped = io::binary::read_intervals(path)) {
+    // Binary files are checked to be distinct and in canonical order
+    return Input{{}, std::move(mapped), {}};
+  } else {
+    std::ifstream file(path);
+    if (!file)
+      return {};
+    text = io::text::read_intervals(file);
+  }
+  if (!text)
+    return {};
+
+  std::vector<Interval> &is = text.value();
+  if (!std::is_sorted(is.begin(), is.end()))
+    std::sort(is.begin(), is.end());
+  is.erase(std::unique(is.begin(), is.end()), is.end());
+  return Input{std::move(is), {}, {}};
+}
+
+static std::optional<Input> read_input(const Options &options) {
+  if (!options.compress)
+    return read_intervals(options.input);
+
+  std::ifstream file;
+  if (options.input != "-") {
+    file.open(options.input);
+    if (!file)
+      return {};
+  }
+  std::istream &is = options.input == "-" ? std::cin : file;
+  if (options.compress == "int")
+    return read_compressed<int64_t>(is);
+  return read_compressed<double>(is);
+}
+
+// Tree as text, in the original values if the input was compressed
+static void write_text_tree(std::ostream &os, const SpanningTree &tree,
+                            const Values &values) {
+  std::visit(
+      [&](const auto &vs) {
+        if constexpr (std::is_same_v<decltype(vs), const std::monostate &>) {
+          io::text::write_tree(os, tree);
+        } else {
+          io::text::write_tree(os, tree, std::span(vs));
+        }
+      },
+      values);
+}
+
+static size_t peak_rss_kb() {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
+static std::string json_string(std::string_view s) {
+  std::string result = "\"";
+  for (char c : s) {
+    if (c == '"' || c == '\\')
+      result += '\\';
+    result += c;
+  }
+  return result + '"';
+}
+
+// Wall time of each phase of a run, in order
+struct Phases {
+  using Clock = std::chrono::steady_clock;
+
+  Clock::time_point start = Clock::now(), last = start;
+  std::vector<std::pair<std::string, double>> times;
+
+  void end(std::string name) {
+    auto now = Clock::now();
+    times.emplace_back(name, std::chrono::duration<double>(now - last).count());
+    last = now;
+  }
+
+  double wall() const {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+  }
+};
+
+// Outcome of a run, printed as one JSON object. Fields are written in order,
+// with extra ones (already formatted) before the timings.
+struct Summary {
+  bool found = false, valid = false;
+  std::optional<size_t> leaves;
+  std::vector<std::pair<std::string, std::string>> extra;
+};
+
+static void print_summary(const Options &options, const registry::Entry &entry,
+                          size_t num_verts, const Summary &summary,
+                          const Phases &phases) {
+  double wall = phases.wall();
+  std::cout << std::setprecision(6) << "{\"solver\": "
+            << json_string(entry.name)
+            << ", \"input\": " << json_string(options.input)
+            << ", \"num_verts\": " << num_verts
+            << ", \"found\": " << (summary.found ? "true" : "false")
+            << ", \"valid\": " << (summary.valid ? "true" : "false")
+            << ", \"leaves\": ";
+  if (summary.leaves) {
+    std::cout << summary.leaves.value();
+  } else {
+    std::cout << "null";
+  }
+  for (const auto &[name, value] : summary.extra) {
+    std::cout << ", " << json_string(name) << ": " << value;
+  }
+  std::cout << ", \"wall_seconds\": " << wall
+            << ", \"peak_rss_kb\": " << peak_rss_kb() << ", \"phases\": {";
+  for (size_t i = 0; i < phases.times.size(); ++i) {
+    std::cout << (i ? ", " : "") << json_string(phases.times[i].first) << ": "
+              << phases.times[i].second;
+  }
+  std::cout << "}}" << std::endl;
+}
+
+static bool report_written(const Options &options, bool written) {
+  if (!written) {
+    std::cerr << "Could not write tree to " << options.tree.value()
+              << std::endl;
+  }
+  return written;
+}
+
+// Builds the representation the solver takes, then runs it
+static std::optional<SpanningTree>
+build_and_solve(const registry::Entry &entry, const std::vector<Interval> &is,
+                Phases &phases) {
+  std::optional<IntervalGraph> interval_graph;
+  std::optional<CompactGraph> compact_graph;
+  std::optional<Graph> graph;
+  std::visit(
+      [&](auto solve) {
+        using Solve = decltype(solve);
+        if constexpr (std::is_invocable_v<Solve, const IntervalGraph &>) {
+          interval_graph.emplace(is);
+        } else if constexpr (std::is_invocable_v<Solve, const CompactGraph &>) {
+          thread_pool::ThreadPool pool;
+          compact_graph.emplace(IntervalGraph(is), pool);
+        } else if constexpr (std::is_invocable_v<Solve, Graph>) {
+          graph = Graph::interval_graph_from_set({is.begin(), is.end()});
+        }
+      },
+      entry.solve);
+  phases.end("build");
+
+  auto tree = std::visit(
+      [&](auto solve) {
+        using Solve = decltype(solve);
+        if constexpr (std::is_invocable_v<Solve, const IntervalGraph &>) {
+          return solve(interval_graph.value());
+        } else if constexpr (std::is_invocable_v<Solve, const CompactGraph &>) {
+          return solve(compact_graph.value());
+        } else if constexpr (std::is_invocable_v<Solve, Graph>) {
+          return solve(std::move(graph.value()));
+        } else {
+          return solve(std::span<const Interval>(is));
+        }
+      },
+      entry.solve);
+  phases.end("solve");
+  return tree;
+}
+
+static int run_tree(const Options &options, const registry::Entry &entry,
+                    const Input &input, Phases &phases) {
+  const std::vector<Interval> &is = input.intervals;
+  std::optional<SpanningTree> tree;
+  if (options.cut_points) {
+    tree = cut_points::solve(is, entry);
+    phases.end("solve");
+  } else if (input.mapped && registry::fits(entry, input.mapped->intervals)) {
+    // Nothing to build, as the solver reads the mapped arrays in place
+    tree = registry::run(entry, input.mapped->intervals);
+    phases.end("solve");
+  } else if (!input.mapped && registry::fits(entry, is)) {
+    tree = build_and_solve(entry, is, phases);
+  } else {
+    std::cerr << "Input is too large for solver " << entry.name << std::endl;
+    return 2;
+  }
+
+  Summary summary;
+  summary.found = tree.has_value();
+  if (tree && input.mapped) {
+    summary.valid = tree->is_spanning_tree_of(input.mapped->intervals);
+  } else if (tree) {
+    summary.valid = tree->is_spanning_tree_of(std::span<const Interval>(is));
+  }
+  phases.end("verify");
+  if (tree)
+    summary.leaves = tree->num_leaves();
+
+  bool written = true;
+  if (tree && options.tree) {
+    const std::string &path = options.tree.value();
+    if (path.ends_with(".bin")) {
+      written = io::binary::write_tree(path, tree.value());
+    } else {
+      std::ofstream file(path);
+      write_text_tree(file, tree.value(), input.values);
+      written = file.good();
+    }
+    phases.end("write");
+  }
+  written = report_written(options, written);
+
+  print_summary(options, entry, input.size(), summary, phases);
+  return summary.found && summary.valid && written ? 0 : 1;
+}
+
+// Solves each connected component alone, reporting totals over the forest
+static int run_forest(const Options &options, const registry::Entry &entry,
+                      const Input &input, Phases &phases) {
+  const std::vector<Interval> &is = input.intervals;
+  auto forest = forest::solve(is, entry);
+  phases.end("solve");
+
+  Summary summary;
+  summary.found = forest.complete();
+  summary.valid = true;
+  for (const auto &result : forest.components) {
+    auto part = std::span<const Interval>(is).subspan(
+        result.component.begin, result.component.size());
+    if (result.tree && !result.tree->is_spanning_tree_of(part))
+      summary.valid = false;
+  }
+  phases.end("verify");
+  summary.leaves = forest.num_leaves();
+
+  size_t num_solved = 0, largest = 0;
+  for (const auto &result : forest.components) {
+    num_solved += result.tree.has_value();
+    largest = std::max(largest, result.component.size());
+  }
+  summary.extra = {
+      {"components", std::to_string(forest.components.size())},
+      {"components_solved", std::to_string(num_solved)},
+      {"largest_component", std::to_string(largest)},
+  };
+
+  bool written = true;
+  if (options.tree) {
+    std::ofstream file(options.tree.value());
+    for (const auto &result : forest.components) {
+      if (result.tree)
+        write_text_tree(file, result.tree.value(), input.values);
+    }
+    written = file.good();
+    phases.end("write");
+  }
+  written = report_written(options, written);
+
+  print_summary(options, entry, is.size(), summary, phases);
+  return summary.found && summary.valid && written ? 0 : 1;
+}
+
+static int run(const Options &options) {
+  Phases phases;
+
+  const registry::Entry *entry = registry::find(options.solver);
+  if (!entry) {
+    std::cerr << "Unknown solver " << options.solver << ", see --list"
+              << std::endl;
+    return 2;
+  }
+
+  auto input = read_input(options);
+  if (!input) {
+    std::cerr << "Could not read intervals from " << options.input
+              << std::endl;
+    return 2;
+  }
+  // Mapped intervals are solved in place by solvers that read them that way,
+  // and copied for the rest
+  if (options.forest || options.cut_points || !entry->solve_arrays)
+    input->unmap();
+  phases.end("parse");
+
+  if (options.forest)
+    return run_forest(options, *entry, input.value(), phases);
+  return run_tree(options, *entry, input.value(), phases);
+}
+
+} // namespace interval_mist
+
+int main(int argc, char **argv) {
+  using namespace interval_mist;
+
+  auto options = parse_args(argc, argv);
+  if (!options) {
+    std::cerr << usage;
+    return 2;
+  }
+  if (options->list) {
+    for (const auto &entry : solvers::registry::entries()) {
+      std::cout << std::left << std::setw(16) << entry.name
+                << entry.description << std::endl;
+    }
+    return 0;
+  }
+  return run(options.value());
+}
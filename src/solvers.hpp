@@ -1,6 +1,8 @@
 #pragma once
 
 #include "solvers/dp.hpp"
+#include "solvers/frontier_dp.hpp"
 #include "solvers/greedy.hpp"
+#include "solvers/greedy_stream.hpp"
 #include "solvers/naive.hpp"
 #include "solvers/path_cover.hpp"
\ No newline at end of file
@@ -1,181 +1,489 @@
 #include "dp.hpp"
 
+#include <algorithm>
 #include <array>
+#include <bit>
+#include <cassert>
 #include <limits>
-#include <map>
-#include <set>
-#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace interval_mist::solvers::dp {
 
-using Vertex = Graph::Vertex;
-using Edge = Graph::Edge;
+// State representation packs 2 bits per vertex, holding:
+// - 0 if isolated
+// - 1 if leaf
+// - 2 if internal
+// for each vertex in the order they appear in verts. Words is fixed at compile
+// time, so small graphs use a single 64-bit word and larger ones 128 bits or
+// more, with digits read by shift and mask and tallied by popcount.
+template <size_t Words> struct State {
+  using Repr = std::array<uint64_t, Words>;
 
-static constexpr size_t max_pow(uint64_t base) {
-  size_t result = 0;
-  uint64_t curr = std::numeric_limits<uint64_t>::max();
-  while (curr > 1) {
-    curr /= base;
-    ++result;
+  static constexpr size_t digits_per_word = 32;
+  static constexpr size_t max_verts = Words * digits_per_word;
+
+  // Low and high bit of every digit
+  static constexpr uint64_t lo_bits = 0x5555555555555555ull;
+  static constexpr uint64_t hi_bits = lo_bits << 1;
+
+  Repr data{};
+
+  bool is_empty() const { return data == Repr{}; }
+
+  uint64_t degree(size_t i) const {
+    return (data[i / digits_per_word] >> (2 * (i % digits_per_word))) & 3;
   }
-  return result;
-}
 
-// State representation is a base-3 number where:
-// - 0 is isolated
-// - 1 is leaf
-// - 2 is internal
-// for each vertex in the order they appear in verts
-// 3^40 is largest power of 3 that can fit in a 64-bit int, so we are limited
-// to 40 vertices.
-struct State {
-  typedef uint64_t Repr;
-
-  static constexpr Repr base = 3;
-  static constexpr size_t max_verts = max_pow(base);
-
-  Repr data;
-  size_t num_verts;
-
-  State(size_t num_verts) : data(0), num_verts(num_verts) {
-    assert(num_verts <= max_verts);
-  }
-
-  Repr pow(size_t p) const {
-    Repr result = 1;
-    Repr curr_base = base;
-    while (p > 0) {
-      if (p & 1)
-        result *= curr_base;
-      curr_base *= curr_base;
-      p >>= 1;
+  void increment(size_t i) {
+    if (degree(i) < 2)
+      data[i / digits_per_word] += uint64_t(1) << (2 * (i % digits_per_word));
+  }
+
+  // Number of vertices of each degree class, of the first num_verts
+  std::array<size_t, 3> counts(size_t num_verts) const {
+    size_t leaves = 0, internal = 0;
+    for (uint64_t word : data) {
+      leaves += std::popcount(word & lo_bits);
+      internal += std::popcount(word & hi_bits);
     }
+    return {num_verts - leaves - internal, leaves, internal};
+  }
+};
+
+// Memo table of DP values and back-pointers, keyed by raw State repr. Open
+// addressing with linear probing over a power of two number of slots, so each
+// state costs one flat entry rather than a node in each of two maps. Keys and
+// entries are held in parallel arrays, so an entry takes three bytes beside
+// its key rather than being padded out to the key's alignment.
+template <size_t Words> struct Table {
+  using Repr = typename State<Words>::Repr;
+
+  // Vertex ids fit in a byte, as do counts of internal vertices
+  static constexpr uint8_t none = std::numeric_limits<uint8_t>::max();
+  static_assert(State<Words>::max_verts < none);
+
+  struct Entry {
+    // Most internal vertices in a spanning tree extending this state, or none
+    // if there is no such tree
+    uint8_t value = none;
+    // First edge added on the way to that tree, or none if there is none
+    uint8_t u = none, v = none;
+  };
+  static_assert(sizeof(Entry) == 3);
+
+  // Every digit 3, which increment never produces
+  static constexpr Repr empty = [] {
+    Repr result;
+    result.fill(std::numeric_limits<uint64_t>::max());
     return result;
+  }();
+
+  // Unused slots hold the empty key, which no state can reach
+  std::vector<Repr> keys;
+  std::vector<Entry> entries;
+  size_t size = 0;
+  size_t max_bytes;
+
+  Table(size_t max_bytes)
+      : keys(16, empty), entries(16), max_bytes(max_bytes) {}
+
+  size_t num_slots() const { return keys.size(); }
+
+  size_t bytes() const {
+    return num_slots() * (sizeof(Repr) + sizeof(Entry));
   }
 
-  void increment(size_t i) {
-    Repr exp = pow(i);
-    Repr dig = (data / exp) % base;
-    if (dig + 1 < base)
-      data += exp;
-  }
-
-  std::vector<Repr> degrees() const {
-    std::vector<Repr> result(num_verts);
-    Repr curr = data;
-    for (size_t i = 0; i < num_verts; ++i) {
-      result[i] = curr % base;
-      curr /= base;
+  static uint64_t hash(const Repr &key) {
+    // Mixes every bit of the key into the high bits. A plain multiplicative
+    // hash is linear, so the successors of states taken in slot order would
+    // land in runs of adjacent slots, which linear probing handles badly.
+    uint64_t result = 0;
+    for (uint64_t word : key) {
+      result = (result ^ word) * 0x9E3779B97F4A7C15ull;
+      result ^= result >> 29;
+      result *= 0xBF58476D1CE4E5B9ull;
+      result ^= result >> 32;
     }
     return result;
   }
 
-  std::array<size_t, base> counts() const {
-    std::array<size_t, base> result{};
-    Repr curr = data;
-    for (size_t i = 0; i < num_verts; ++i) {
-      ++result[curr % base];
-      curr /= base;
+  const Entry *find(const Repr &key) const {
+    for (size_t i = slot(key);; i = (i + 1) & (num_slots() - 1)) {
+      if (keys[i] == key)
+        return &entries[i];
+      if (keys[i] == empty)
+        return nullptr;
     }
-    return result;
   }
 
-  friend auto operator<=>(const State &, const State &) = default;
+  Entry *find(const Repr &key) {
+    return const_cast<Entry *>(std::as_const(*this).find(key));
+  }
+
+  // Returns false if growing the table would exceed max_bytes
+  bool insert(const Repr &key, Entry entry) {
+    if (4 * (size + 1) > 3 * num_slots() && !grow())
+      return false;
+    place(key, entry);
+    ++size;
+    return true;
+  }
 
-  size_t hash() const { return ::std::hash<Repr>{}(data); }
-};
+private:
+  size_t slot(const Repr &key) const {
+    return hash(key) >> (64 - std::countr_zero(num_slots()));
+  }
 
-struct StateHash {
-  size_t operator()(State const &state) const noexcept { return state.hash(); }
+  void place(const Repr &key, Entry entry) {
+    size_t i = slot(key);
+    while (keys[i] != empty) {
+      i = (i + 1) & (num_slots() - 1);
+    }
+    keys[i] = key;
+    entries[i] = entry;
+  }
+
+  bool grow() {
+    if (2 * bytes() > max_bytes)
+      return false;
+    std::vector<Repr> old_keys(2 * num_slots(), empty);
+    std::vector<Entry> old_entries(2 * num_slots());
+    std::swap(old_keys, keys);
+    std::swap(old_entries, entries);
+    for (size_t i = 0; i < old_keys.size(); ++i) {
+      if (old_keys[i] != empty)
+        place(old_keys[i], old_entries[i]);
+    }
+    return true;
+  }
 };
 
 // DP to find maximum number of internal nodes in a spanning tree of a graph
-// Returns {} if no spanning tree can be found
-// Case for state > 0: Some edges already exist in the tree
-std::optional<size_t>
-dpf(std::unordered_map<State, std::optional<size_t>, StateHash> &dpt,
-    std::unordered_map<State, std::pair<size_t, size_t>, StateHash> &trace,
-    const std::vector<std::vector<size_t>> &adj, State state) {
-  // Use memoized value if available
-  if (auto it = dpt.find(state); it != dpt.end())
-    return it->second;
+// For each state (degree class of each vertex after adding some edges), finds
+// the best value over all edges joining a vertex in the tree to one not yet in
+// it. Runs as an explicit depth-first search so deep states cannot overflow
+// the call stack. Returns false if the table outgrew its memory cap.
+template <size_t Words>
+static bool dpf(Table<Words> &table, const CompactGraph &g) {
+  using State = State<Words>;
+  using Table = Table<Words>;
+
+  struct Frame {
+    Frame(State state) : state(state) {}
+
+    State state;
+    // Next edge to try, as a vertex and an index into its neighbours
+    size_t u = 0, k = 0;
+    std::optional<size_t> best;
+    uint8_t best_u = Table::none, best_v = Table::none;
+  };
+
+  std::vector<Frame> stack;
+  stack.emplace_back(State());
+
+  while (!stack.empty()) {
+    Frame &frame = stack.back();
+    const State &state = frame.state;
+
+    // Base case: Graph is already connected
+    if (auto counts = state.counts(g.num_verts()); counts[0] == 0) {
+      if (!table.insert(state.data, {static_cast<uint8_t>(counts[2])}))
+        return false;
+      stack.pop_back();
+      continue;
+    }
+
+    bool first_edge = state.is_empty();
+
+    // Advance to the next edge whose substate is not yet known, folding in
+    // those that are
+    std::optional<State> unknown;
+    for (; frame.u < g.num_verts(); ++frame.u, frame.k = 0) {
+      if (!first_edge && state.degree(frame.u) == 0)
+        continue;
 
-  // Base case: Graph is already connected
-  if (auto counts = state.counts(); counts[0] == 0) {
-    return dpt[state] = counts[2];
+      auto neighbours = g.neighbours(frame.u);
+      for (; frame.k < neighbours.size(); ++frame.k) {
+        size_t v = neighbours[frame.k];
+        if (state.degree(v) != 0)
+          continue;
+
+        State substate = state;
+        substate.increment(frame.u);
+        substate.increment(v);
+
+        const typename Table::Entry *entry = table.find(substate.data);
+        if (!entry) {
+          unknown = substate;
+          break;
+        }
+        if (entry->value == Table::none)
+          continue;
+
+        if (!frame.best || entry->value > frame.best.value()) {
+          frame.best = entry->value;
+          frame.best_u = frame.u;
+          frame.best_v = v;
+        }
+      }
+      if (unknown)
+        break;
+    }
+
+    // Recurse on the unknown substate, revisiting this edge once it is known
+    if (unknown) {
+      stack.emplace_back(unknown.value());
+      continue;
+    }
+
+    uint8_t value = frame.best ? frame.best.value() : Table::none;
+    if (!table.insert(state.data, {value, frame.best_u, frame.best_v}))
+      return false;
+    stack.pop_back();
   }
 
-  std::optional<size_t> best;
-  std::optional<std::pair<size_t, size_t>> edge;
+  return true;
+}
+
+template <size_t Words>
+static std::optional<SpanningTree> solve(const CompactGraph &g, Stats &stats,
+                                         size_t max_table_bytes) {
+  using Table = Table<Words>;
+
+  Table table(max_table_bytes);
+
+  bool complete = dpf(table, g);
+  stats.table_entries = table.size;
+  stats.table_bytes = table.bytes();
+  stats.out_of_memory = !complete;
+  if (!complete)
+    return {};
+
+  State<Words> state;
+  const typename Table::Entry *entry = table.find(state.data);
+  if (entry->value == Table::none)
+    return {};
+
+  SpanningTree tree(g.vertices());
+  for (; entry->u != Table::none; entry = table.find(state.data)) {
+    tree.add_edge(entry->u, entry->v);
+    state.increment(entry->u);
+    state.increment(entry->v);
+  }
+  return tree;
+}
 
-  bool first_edge = state.data == 0;
-  auto degrees = state.degrees();
+std::optional<SpanningTree> interval_mist_dp(const CompactGraph &g,
+                                             Stats &stats,
+                                             size_t max_table_bytes) {
+  // A lone vertex is already a tree, with no edge for the DP to add
+  if (g.num_verts() == 1) {
+    stats = Stats();
+    return SpanningTree(g.vertices());
+  }
+  // Use the narrowest state that fits, as it makes for smaller table entries
+  if (g.num_verts() <= State<1>::max_verts)
+    return solve<1>(g, stats, max_table_bytes);
+  if (g.num_verts() <= State<2>::max_verts)
+    return solve<2>(g, stats, max_table_bytes);
+  static_assert(State<4>::max_verts == max_verts);
+  if (g.num_verts() <= State<4>::max_verts)
+    return solve<4>(g, stats, max_table_bytes);
+  stats = Stats();
+  return {};
+}
 
-  for (size_t u = 0; u < adj.size(); ++u) {
-    if (!first_edge && degrees[u] == 0)
+// Calls fn(u, v, substate) for each edge that can be added to state, in the
+// order dpf tries them
+template <size_t Words, typename Fn>
+static void for_each_successor(const CompactGraph &g,
+                               const State<Words> &state, Fn fn) {
+  bool first_edge = state.is_empty();
+  for (size_t u = 0; u < g.num_verts(); ++u) {
+    if (!first_edge && state.degree(u) == 0)
       continue;
 
-    for (size_t v : adj[u]) {
-      if (degrees[v] != 0)
+    for (size_t v : g.neighbours(u)) {
+      if (state.degree(v) != 0)
         continue;
 
-      State substate = state;
+      State<Words> substate = state;
       substate.increment(u);
       substate.increment(v);
+      fn(u, v, substate);
+    }
+  }
+}
 
-      auto option = dpf(dpt, trace, adj, substate);
-      if (!option)
-        continue;
-
-      if (!best || option.value() > best.value()) {
-        best = option;
-        edge = std::make_pair(u, v);
+// Level-synchronous form of dpf. Every edge added moves a state from layer k
+// (states with k edges) to layer k + 1, so layers are built forwards and then
+// valued backwards, each across the pool. Layers are split into shards by
+// hash, with each shard written by one task at a time so that no locking is
+// needed. Ties are broken as in dpf, so both find the same tree.
+template <size_t Words>
+static std::optional<SpanningTree> solve_layered(const CompactGraph &g,
+                                                 thread_pool::ThreadPool &pool,
+                                                 Stats &stats,
+                                                 size_t max_table_bytes) {
+  using State = State<Words>;
+  using Table = Table<Words>;
+  using Repr = typename Table::Repr;
+  using Layer = std::vector<Table>;
+
+  size_t num_shards = 4 * pool.num_threads();
+  auto shard_of = [num_shards](const State &state) {
+    return (Table::hash(state.data) >> 32) % num_shards;
+  };
+  // The cap covers every layer, so the shards of each new layer split what
+  // the layers before it left, and none can grow past its part
+  auto make_layer = [&]() {
+    size_t used = std::min(stats.table_bytes, max_table_bytes);
+    return Layer(num_shards, Table((max_table_bytes - used) / num_shards));
+  };
+
+  auto finish = [&](std::vector<Layer> &layers, bool complete) {
+    stats.table_entries = stats.table_bytes = 0;
+    for (const Layer &layer : layers) {
+      for (const Table &table : layer) {
+        stats.table_entries += table.size;
+        stats.table_bytes += table.bytes();
       }
     }
-  }
+    stats.out_of_memory = !complete || stats.table_bytes > max_table_bytes;
+    return !stats.out_of_memory;
+  };
+
+  stats = Stats();
+  std::vector<Layer> layers;
+  layers.push_back(make_layer());
+  layers[0][shard_of(State())].insert(State().data, {});
+
+  // Forwards: collect successors of each shard by destination shard, then
+  // have each destination shard take in its own
+  while (true) {
+    const Layer &layer = layers.back();
+    std::vector<std::vector<std::vector<Repr>>> outbox(
+        num_shards, std::vector<std::vector<Repr>>(num_shards));
+    pool.parallel_for(num_shards, [&](size_t s) {
+      for (const Repr &key : layer[s].keys) {
+        State state{key};
+        if (key == Table::empty || state.counts(g.num_verts())[0] == 0)
+          continue;
+        for_each_successor(g, state, [&](size_t, size_t, const State &sub) {
+          outbox[s][shard_of(sub)].push_back(sub.data);
+        });
+      }
+    });
 
-  if (edge)
-    trace[state] = edge.value();
-  return dpt[state] = best;
-}
+    bool empty = true;
+    for (const auto &row : outbox) {
+      for (const auto &keys : row) {
+        empty = empty && keys.empty();
+      }
+    }
+    if (empty)
+      break;
+
+    Layer next = make_layer();
+    std::vector<char> complete(num_shards, true);
+    pool.parallel_for(num_shards, [&](size_t t) {
+      for (size_t s = 0; s < num_shards && complete[t]; ++s) {
+        for (const Repr &key : outbox[s][t]) {
+          if (!next[t].find(key) && !next[t].insert(key, {})) {
+            complete[t] = false;
+            break;
+          }
+        }
+      }
+    });
+    layers.push_back(std::move(next));
 
-std::optional<Graph> interval_mist_dp(Graph g) {
-  // Build vertex <-> id mapping
-  std::vector<Vertex> id_to_vert;
-  std::map<Vertex, size_t> vert_to_id;
-  for (Vertex v : g.verts) {
-    vert_to_id[v] = id_to_vert.size();
-    id_to_vert.push_back(v);
+    bool all_complete = std::all_of(complete.begin(), complete.end(),
+                                    [](char c) { return c; });
+    if (!finish(layers, all_complete))
+      return {};
   }
 
-  // Build adjacency list
-  std::vector<std::vector<size_t>> adj(id_to_vert.size());
-  for (Edge e : g.edges) {
-    size_t u = vert_to_id[e.src];
-    size_t v = vert_to_id[e.dst];
-    adj[u].push_back(v);
-    adj[v].push_back(u);
+  // Backwards: value each state from the layer after it
+  for (size_t k = layers.size(); k-- > 0;) {
+    pool.parallel_for(num_shards, [&](size_t s) {
+      Table &table = layers[k][s];
+      for (size_t i = 0; i < table.num_slots(); ++i) {
+        if (table.keys[i] == Table::empty)
+          continue;
+        State state{table.keys[i]};
+        auto &entry = table.entries[i];
+
+        // Base case: Graph is already connected
+        if (auto counts = state.counts(g.num_verts()); counts[0] == 0) {
+          entry.value = counts[2];
+          continue;
+        }
+
+        std::optional<size_t> best;
+        for_each_successor(g, state, [&](size_t u, size_t v, const State &sub) {
+          const auto *option = layers[k + 1][shard_of(sub)].find(sub.data);
+          if (option->value == Table::none)
+            return;
+          if (!best || option->value > best.value()) {
+            best = option->value;
+            entry.u = u;
+            entry.v = v;
+          }
+        });
+        entry.value = best ? best.value() : Table::none;
+      }
+    });
   }
 
-  std::unordered_map<State, std::optional<size_t>, StateHash> dpt;
-  std::unordered_map<State, std::pair<size_t, size_t>, StateHash> trace;
-
-  State initial_state(adj.size());
+  finish(layers, true);
 
-  if (!dpf(dpt, trace, adj, initial_state))
+  State state;
+  const auto *entry = layers[0][shard_of(state)].find(state.data);
+  if (entry->value == Table::none)
     return {};
 
-  std::set<Edge> tree_edges;
-  for (State state = initial_state; trace.count(state);) {
-    size_t u, v;
-    std::tie(u, v) = trace.at(state);
-    tree_edges.insert(Edge(id_to_vert[u], id_to_vert[v]));
-    state.increment(u);
-    state.increment(v);
+  SpanningTree tree(g.vertices());
+  for (size_t k = 1; entry->u != Table::none; ++k) {
+    tree.add_edge(entry->u, entry->v);
+    state.increment(entry->u);
+    state.increment(entry->v);
+    entry = layers[k][shard_of(state)].find(state.data);
   }
+  return tree;
+}
+
+std::optional<SpanningTree>
+interval_mist_dp_parallel(const CompactGraph &g, thread_pool::ThreadPool &pool,
+                          Stats &stats, size_t max_table_bytes) {
+  if (g.num_verts() == 1) {
+    stats = Stats();
+    return SpanningTree(g.vertices());
+  }
+  if (g.num_verts() <= State<1>::max_verts)
+    return solve_layered<1>(g, pool, stats, max_table_bytes);
+  if (g.num_verts() <= State<2>::max_verts)
+    return solve_layered<2>(g, pool, stats, max_table_bytes);
+  if (g.num_verts() <= State<4>::max_verts)
+    return solve_layered<4>(g, pool, stats, max_table_bytes);
+  stats = Stats();
+  return {};
+}
+
+std::optional<SpanningTree> interval_mist_dp_parallel(Graph g) {
+  static thread_pool::ThreadPool pool;
+  Stats stats;
+  return interval_mist_dp_parallel(CompactGraph(g), pool, stats);
+}
+
+std::optional<SpanningTree> interval_mist_dp(const CompactGraph &g) {
+  Stats stats;
+  return interval_mist_dp(g, stats);
+}
 
-  return Graph(g.verts, tree_edges);
+std::optional<SpanningTree> interval_mist_dp(Graph g) {
+  return interval_mist_dp(CompactGraph(g));
 }
 
 } // namespace interval_mist::solvers::dp
\ No newline at end of file
@@ -1,13 +1,53 @@
 #pragma once
 
+#include "../compact_graph.hpp"
 #include "../graph.hpp"
+#include "../spanning_tree.hpp"
+#include "../thread_pool.hpp"
 
+#include <cstddef>
 #include <optional>
 
 namespace interval_mist::solvers::dp {
 
+using CompactGraph = interval_mist::graph::CompactGraph;
 using Graph = interval_mist::graph::Graph;
+using SpanningTree = interval_mist::graph::SpanningTree;
 
-std::optional<Graph> interval_mist_dp(Graph g);
+// Size of the DP memo table, for estimating the memory a job will need
+struct Stats {
+  size_t table_entries = 0;
+  // Peak memory held by the table
+  size_t table_bytes = 0;
+  // Whether the solve was abandoned for exceeding the memory cap
+  bool out_of_memory = false;
+};
+
+static constexpr size_t default_max_table_bytes = size_t(1) << 32;
+
+// Largest graph the exact solvers take. Larger ones get {}.
+static constexpr size_t max_verts = 128;
+
+// Exact solver, exponential in the number of vertices
+std::optional<SpanningTree> interval_mist_dp(Graph g);
+
+std::optional<SpanningTree> interval_mist_dp(const CompactGraph &g);
+
+// Returns {} if g has no spanning tree, or if the memo table would grow past
+// max_table_bytes (in which case stats.out_of_memory is set)
+std::optional<SpanningTree>
+interval_mist_dp(const CompactGraph &g, Stats &stats,
+                 size_t max_table_bytes = default_max_table_bytes);
+
+// As interval_mist_dp, but exploring states a layer at a time across pool. The
+// table cap applies to all layers together, and each layer's shards split
+// what is left of it as the layer is built.
+std::optional<SpanningTree>
+interval_mist_dp_parallel(const CompactGraph &g, thread_pool::ThreadPool &pool,
+                          Stats &stats,
+                          size_t max_table_bytes = default_max_table_bytes);
+
+// Runs on a pool shared between calls, with a thread per core
+std::optional<SpanningTree> interval_mist_dp_parallel(Graph g);
 
 } // namespace interval_mist::solvers::dp
\ No newline at end of file
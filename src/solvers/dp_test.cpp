@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+
+#include "../generators/intervals.hpp"
+#include "dp.hpp"
+#include "frontier_dp.hpp"
+#include "greedy.hpp"
+#include "naive.hpp"
+
+#include <set>
+#include <vector>
+
+namespace interval_mist::solvers::dp {
+
+using Vertex = Graph::Vertex;
+
+// Path of num intervals, each meeting only the one before and after
+static Graph path(size_t num) {
+  std::set<Vertex> vs;
+  for (size_t i = 0; i < num; ++i) {
+    vs.insert(Vertex(i, i + 1));
+  }
+  return Graph::interval_graph_from_set(vs);
+}
+
+TEST(DpTest, MatchesNaive) {
+  for (size_t seed = 0; seed < 50; ++seed) {
+    Graph g = Graph::random_connected_interval_graph(seed, 2 + seed % 7);
+    auto expected = naive::interval_mist_naive(g);
+    auto actual = interval_mist_dp(g);
+    ASSERT_TRUE(expected.has_value());
+    ASSERT_TRUE(actual.has_value());
+    EXPECT_TRUE(actual->is_spanning_tree_of(g.verts));
+    EXPECT_EQ(expected->num_leaves(), actual->num_leaves());
+  }
+}
+
+TEST(DpTest, Disconnected) {
+  Graph g = Graph::interval_graph_from_set({Vertex(0, 1), Vertex(2, 3)});
+  Stats stats;
+  EXPECT_FALSE(interval_mist_dp(CompactGraph(g), stats));
+  EXPECT_FALSE(stats.out_of_memory);
+}
+
+TEST(DpTest, DeepSearch) {
+  // Every state on the way to the tree is one edge deeper, so the search
+  // reaches a depth of 31 states
+  Graph g = path(32);
+  auto tree = interval_mist_dp(g);
+  ASSERT_TRUE(tree.has_value());
+  EXPECT_TRUE(tree->is_spanning_tree_of(g.verts));
+  EXPECT_EQ(2, tree->num_leaves());
+}
+
+TEST(DpTest, Stats) {
+  Stats small, large;
+  CompactGraph g(Graph::random_connected_interval_graph(1, 8));
+  CompactGraph h(Graph::random_connected_interval_graph(1, 11));
+  ASSERT_TRUE(interval_mist_dp(g, small));
+  ASSERT_TRUE(interval_mist_dp(h, large));
+  EXPECT_FALSE(small.out_of_memory);
+  EXPECT_GT(small.table_entries, 0);
+  // Each entry takes its 8 byte key and 3 bytes more, at most 3 / 4 full
+  EXPECT_GE(small.table_bytes, 4 * small.table_entries * 11 / 3);
+  EXPECT_GT(large.table_entries, small.table_entries);
+  EXPECT_GT(large.table_bytes, small.table_bytes);
+}
+
+TEST(DpTest, OutOfMemory) {
+  CompactGraph g(Graph::random_connected_interval_graph(2, 12));
+  Stats stats;
+  EXPECT_FALSE(interval_mist_dp(g, stats, 4096));
+  EXPECT_TRUE(stats.out_of_memory);
+  EXPECT_LE(stats.table_bytes, 4096);
+
+  // The same instance solves under the default cap
+  EXPECT_TRUE(interval_mist_dp(g, stats));
+  EXPECT_FALSE(stats.out_of_memory);
+  EXPECT_GT(stats.table_bytes, 4096);
+}
+
+TEST(DpTest, ParallelMatchesSerial) {
+  for (size_t threads : {1, 2, 3, 8}) {
+    thread_pool::ThreadPool pool(threads);
+    for (size_t seed = 0; seed < 20; ++seed) {
+      Graph g = Graph::random_connected_interval_graph(seed, 1 + seed % 10);
+      Stats serial_stats, parallel_stats;
+      auto expected = interval_mist_dp(CompactGraph(g), serial_stats);
+      auto actual =
+          interval_mist_dp_parallel(CompactGraph(g), pool, parallel_stats);
+      ASSERT_EQ(expected.has_value(), actual.has_value());
+      if (expected) {
+        EXPECT_EQ(expected->to_graph(), actual->to_graph());
+      }
+      // Every state is held once, in the layer of its number of edges
+      EXPECT_EQ(serial_stats.table_entries, parallel_stats.table_entries);
+      EXPECT_FALSE(parallel_stats.out_of_memory);
+    }
+  }
+}
+
+TEST(DpTest, ParallelOutOfMemory) {
+  CompactGraph g(Graph::random_connected_interval_graph(2, 12));
+  Stats serial;
+  ASSERT_TRUE(interval_mist_dp(g, serial));
+
+  // Shards split the cap rather than each taking all of it
+  size_t cap = serial.table_bytes / 2;
+  for (size_t threads : {1, 4}) {
+    thread_pool::ThreadPool pool(threads);
+    Stats stats;
+    EXPECT_FALSE(interval_mist_dp_parallel(g, pool, stats, cap));
+    EXPECT_TRUE(stats.out_of_memory);
+    EXPECT_LE(stats.table_bytes, cap);
+  }
+}
+
+TEST(DpTest, WideStates) {
+  // Paths of one, two and four words of state
+  for (size_t num : {32, 33, 41, 64, 65, 100, 128}) {
+    Graph g = path(num);
+    Stats stats;
+    auto tree = interval_mist_dp(CompactGraph(g), stats);
+    ASSERT_TRUE(tree.has_value()) << num;
+    EXPECT_TRUE(tree->is_spanning_tree_of(g.verts));
+    EXPECT_EQ(2, tree->num_leaves());
+    EXPECT_FALSE(stats.out_of_memory);
+  }
+}
+
+TEST(DpTest, WideStatesMatchFrontierDp) {
+  namespace intervals = generators::intervals;
+  for (size_t num : {41, 56, 72, 96}) {
+    for (size_t seed = 0; seed < 3; ++seed) {
+      auto is = intervals::near_path(seed, num, 0.02);
+      Graph g = Graph::interval_graph_from_set(std::set(is.begin(), is.end()));
+      auto expected = frontier_dp::interval_mist_frontier_dp(g);
+      auto greedy = greedy::interval_mist_greedy(g);
+      auto actual = interval_mist_dp(g);
+      ASSERT_TRUE(expected.has_value());
+      ASSERT_TRUE(actual.has_value());
+      EXPECT_TRUE(actual->is_spanning_tree_of(g.verts));
+      EXPECT_EQ(expected->num_leaves(), actual->num_leaves());
+      EXPECT_LE(actual->num_leaves(), greedy->num_leaves());
+    }
+  }
+}
+
+TEST(DpTest, TooLarge) {
+  CompactGraph g(path(max_verts + 1));
+  Stats stats;
+  EXPECT_FALSE(interval_mist_dp(g, stats));
+  EXPECT_FALSE(stats.out_of_memory);
+  thread_pool::ThreadPool pool(2);
+  EXPECT_FALSE(interval_mist_dp_parallel(g, pool, stats));
+  EXPECT_FALSE(stats.out_of_memory);
+}
+
+} // namespace interval_mist::solvers::dp
@@ -0,0 +1,247 @@
+#include "frontier_dp.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <unordered_map>
+#include <vector>
+
+namespace interval_mist::solvers::frontier_dp {
+
+using Vertex = Graph::Vertex;
+
+// State representation is, for each open interval in the order they opened,
+// its degree class:
+// - 0 is isolated
+// - 1 is leaf
+// - 2 is internal
+// and the component of the partial forest containing it. Components are
+// numbered by first appearance, so equal forests give equal states. Packed in
+// 6 bits per interval, limiting us to max_clique open intervals.
+struct State {
+  typedef uint64_t Repr;
+
+  static constexpr size_t bits = 6;
+  static_assert(max_clique * bits <= 64);
+
+  size_t size;
+  std::array<uint8_t, max_clique> degree{}, component{};
+
+  State(Repr data, size_t size) : size(size) {
+    for (size_t i = 0; i < size; ++i) {
+      degree[i] = (data >> (bits * i)) & 3;
+      component[i] = (data >> (bits * i + 2)) & 15;
+    }
+  }
+
+  Repr data() const {
+    Repr result = 0;
+    for (size_t i = 0; i < size; ++i) {
+      result |= Repr(degree[i] | component[i] << 2) << (bits * i);
+    }
+    return result;
+  }
+
+  size_t num_components() const {
+    return size == 0 ? 0
+                     : *std::max_element(component.begin(),
+                                         component.begin() + size) +
+                           1;
+  }
+
+  void increment(size_t i) { degree[i] = std::min(degree[i] + 1, 2); }
+
+  // Whether no other open interval shares a component with i
+  bool alone(size_t i) const {
+    for (size_t j = 0; j < size; ++j) {
+      if (j != i && component[j] == component[i])
+        return false;
+    }
+    return true;
+  }
+
+  void erase(size_t i) {
+    std::copy(degree.begin() + i + 1, degree.begin() + size,
+              degree.begin() + i);
+    std::copy(component.begin() + i + 1, component.begin() + size,
+              component.begin() + i);
+    --size;
+    renumber();
+  }
+
+  void renumber() {
+    std::array<uint8_t, max_clique> names;
+    names.fill(max_clique);
+    uint8_t next = 0;
+    for (size_t i = 0; i < size; ++i) {
+      uint8_t &name = names[component[i]];
+      if (name == max_clique)
+        name = next++;
+      component[i] = name;
+    }
+  }
+};
+
+// Best internal count of forgotten vertices over forests giving a state
+struct Node {
+  State::Repr data;
+  size_t value;
+};
+
+// How a node was reached: the node it came from in the previous step and, on
+// opening an interval, which open intervals it was joined to
+struct Back {
+  uint32_t parent;
+  uint16_t edges;
+};
+
+std::optional<SpanningTree> interval_mist_frontier_dp(Graph g) {
+  struct Event {
+    Vertex vert;
+    bool open;
+
+    // As in Graph::interval_graph_from_set, opens before closes at the same
+    // coordinate so that touching intervals meet
+    std::weak_ordering operator<=>(const Event &rhs) const {
+      Vertex::Coord lc = open ? vert.lower : vert.upper;
+      Vertex::Coord rc = rhs.open ? rhs.vert.lower : rhs.vert.upper;
+      if (auto cmp = lc <=> rc; cmp != 0)
+        return cmp;
+      return rhs.open <=> open;
+    }
+  };
+
+  std::vector<Event> events;
+  for (auto vert : g.verts) {
+    events.push_back({vert, true});
+    events.push_back({vert, false});
+  }
+  std::sort(events.begin(), events.end());
+
+  // The state has room for max_clique open intervals, so give up before any
+  // exponential work on a larger clique
+  size_t last_open = 0;
+  for (size_t step = 0, num_open = 0; step < events.size(); ++step) {
+    if (!events[step].open) {
+      --num_open;
+    } else if (++num_open > max_clique) {
+      return {};
+    } else {
+      last_open = step;
+    }
+  }
+
+  std::vector<Vertex> open;
+  // Intervals open just before each step that opens one
+  std::vector<std::vector<Vertex>> opened_into(events.size());
+  std::vector<std::vector<Back>> trace(events.size());
+
+  std::vector<Node> curr = {{0, 0}};
+  std::unordered_map<State::Repr, uint32_t> index;
+
+  for (size_t step = 0; step < events.size(); ++step) {
+    const Event &event = events[step];
+    std::vector<Node> next;
+    std::vector<Back> &back = trace[step];
+    index.clear();
+
+    auto visit = [&](const State &state, size_t value, Back from) {
+      auto [it, inserted] = index.emplace(state.data(), next.size());
+      if (inserted) {
+        next.push_back({state.data(), value});
+        back.push_back(from);
+      } else if (value > next[it->second].value) {
+        next[it->second].value = value;
+        back[it->second] = from;
+      }
+    };
+
+    if (event.open) {
+      // The new interval meets every open one, and may be joined to at most
+      // one interval of each component without closing a cycle
+      size_t m = open.size();
+      assert(m < max_clique);
+
+      for (size_t i = 0; i < curr.size(); ++i) {
+        State state(curr[i].data, m);
+        size_t num_components = state.num_components();
+        std::vector<std::vector<size_t>> members(num_components);
+        for (size_t p = 0; p < m; ++p) {
+          members[state.component[p]].push_back(p);
+        }
+
+        // Mixed radix count over which member (if any) of each component to
+        // join to, with 0 meaning none
+        std::vector<size_t> choice(num_components, 0);
+        while (true) {
+          State substate = state;
+          substate.size = m + 1;
+          substate.component[m] = num_components;
+          uint16_t edges = 0;
+          for (size_t c = 0; c < num_components; ++c) {
+            if (choice[c] == 0)
+              continue;
+            size_t p = members[c][choice[c] - 1];
+            edges |= 1 << p;
+            substate.increment(p);
+            substate.increment(m);
+          }
+          for (size_t p = 0; p < m; ++p) {
+            if (choice[state.component[p]] != 0)
+              substate.component[p] = num_components;
+          }
+          substate.renumber();
+          visit(substate, curr[i].value, {static_cast<uint32_t>(i), edges});
+
+          size_t c = 0;
+          while (c < num_components && ++choice[c] > members[c].size()) {
+            choice[c++] = 0;
+          }
+          if (c == num_components)
+            break;
+        }
+      }
+
+      opened_into[step] = open;
+      open.push_back(event.vert);
+    } else {
+      // A closing interval can no longer gain edges, so its component must
+      // reach some other open interval, unless it is the whole tree
+      size_t m = open.size();
+      size_t p = std::find(open.begin(), open.end(), event.vert) - open.begin();
+      bool last = m == 1 && step > last_open;
+
+      for (size_t i = 0; i < curr.size(); ++i) {
+        State state(curr[i].data, m);
+        if (!last && state.alone(p))
+          continue;
+        size_t value = curr[i].value + (state.degree[p] == 2);
+        state.erase(p);
+        visit(state, value, {static_cast<uint32_t>(i), 0});
+      }
+
+      open.erase(open.begin() + p);
+    }
+
+    curr = std::move(next);
+    // Nothing can connect the intervals seen so far to those to come
+    if (curr.empty())
+      return {};
+  }
+
+  // Walk the trace back from the single empty state left at the end
+  SpanningTree tree(std::vector<Vertex>(g.verts.begin(), g.verts.end()));
+  for (size_t step = events.size(), i = 0; step-- > 0;) {
+    const Back &from = trace[step][i];
+    for (uint16_t edges = from.edges; edges; edges &= edges - 1) {
+      tree.add_edge(events[step].vert,
+                    opened_into[step][std::countr_zero(edges)]);
+    }
+    i = from.parent;
+  }
+
+  return tree;
+}
+
+} // namespace interval_mist::solvers::frontier_dp
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "../graph.hpp"
+#include "../spanning_tree.hpp"
+
+#include <optional>
+
+namespace interval_mist::solvers::frontier_dp {
+
+using Graph = interval_mist::graph::Graph;
+using SpanningTree = interval_mist::graph::SpanningTree;
+
+// Largest number of intervals that may be open at once
+static constexpr size_t max_clique = 10;
+
+// Exact solver sweeping the intervals left to right, as in
+// Graph::interval_graph_from_set. The DP state covers only the intervals open
+// at the sweep (each one's degree class, and which of them the partial forest
+// already connects), so cost is linear in the number of intervals but
+// exponential in the largest clique. Returns {} if that is more than
+// max_clique. Only the vertices of g are used, as its edges follow from them.
+std::optional<SpanningTree> interval_mist_frontier_dp(Graph g);
+
+} // namespace interval_mist::solvers::frontier_dp
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#include "../generators/intervals.hpp"
+#include "dp.hpp"
+#include "frontier_dp.hpp"
+
+#include <set>
+#include <vector>
+
+namespace interval_mist::solvers::frontier_dp {
+
+namespace intervals = generators::intervals;
+
+using Vertex = Graph::Vertex;
+
+static Graph graph_of(const std::vector<Vertex> &is) {
+  return Graph::interval_graph_from_set(std::set(is.begin(), is.end()));
+}
+
+TEST(FrontierDpTest, MatchesDp) {
+  for (intervals::Family family : intervals::families) {
+    for (size_t num = 1; num <= 12; ++num) {
+      for (size_t seed = 0; seed < 3; ++seed) {
+        Graph g = graph_of(intervals::generate(family, seed, num));
+        SCOPED_TRACE(intervals::name(family) + " " + std::to_string(num) +
+                     " " + std::to_string(seed));
+        auto expected = dp::interval_mist_dp(g);
+        auto actual = interval_mist_frontier_dp(g);
+        ASSERT_EQ(expected.has_value(), actual.has_value());
+        if (actual) {
+          EXPECT_TRUE(actual->is_spanning_tree_of(g.verts));
+          EXPECT_EQ(expected->num_leaves(), actual->num_leaves());
+        }
+      }
+    }
+  }
+}
+
+TEST(FrontierDpTest, Disconnected) {
+  Graph g = graph_of({Vertex(0, 1), Vertex(2, 3)});
+  EXPECT_FALSE(dp::interval_mist_dp(g));
+  EXPECT_FALSE(interval_mist_frontier_dp(g));
+}
+
+TEST(FrontierDpTest, SingleVertex) {
+  Graph g = graph_of({Vertex(0, 1)});
+  auto expected = dp::interval_mist_dp(g);
+  auto actual = interval_mist_frontier_dp(g);
+  ASSERT_TRUE(expected.has_value());
+  ASSERT_TRUE(actual.has_value());
+  EXPECT_EQ(1, actual->num_verts());
+  EXPECT_EQ(expected->to_graph(), actual->to_graph());
+}
+
+TEST(FrontierDpTest, CliqueTooLarge) {
+  // Nested intervals are all open at once
+  std::vector<Vertex> is;
+  for (size_t i = 0; i <= max_clique; ++i) {
+    is.push_back(Vertex(i, 2 * max_clique + 1 - i));
+  }
+  EXPECT_FALSE(interval_mist_frontier_dp(graph_of(is)));
+
+  // Within the limit everywhere but one clique, deep in the sweep and
+  // touching the last interval before it
+  is = intervals::bounded_clique(0, 40, max_clique / 2);
+  Vertex::Coord end = is.back().upper;
+  for (size_t i = 0; i <= max_clique; ++i) {
+    is.push_back(Vertex(end + i, end + 2 * max_clique + 1 - i));
+  }
+  EXPECT_FALSE(interval_mist_frontier_dp(graph_of(is)));
+}
+
+} // namespace interval_mist::solvers::frontier_dp
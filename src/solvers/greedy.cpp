@@ -2,8 +2,11 @@
 
 #include "dp.hpp"
 
-#include <map>
+#include "../lower_tree.hpp"
+
+#include <algorithm>
 #include <set>
+#include <vector>
 
 namespace interval_mist::solvers::greedy {
 
@@ -11,47 +14,41 @@ static constexpr bool featureAssertPrefixProperty = false;
 static constexpr bool featureAssertRootLeafProperty = true;
 
 using Vertex = Graph::Vertex;
-using Edge = Graph::Edge;
-
-std::optional<Graph> interval_mist_greedy(Graph g) {
-  auto [vs, es] = g;
-
-  // Construct adjacency list
-  std::map<Vertex, std::set<Vertex>> adjlist;
-  for (auto [u, v] : es) {
-    assert(vs.count(u));
-    assert(vs.count(v));
-    adjlist[u].insert(v);
-    adjlist[v].insert(u);
-  }
+
+// Greedy over a graph exposing dense ids in canonical order and a
+// find_neighbour(u, pred) query for the LRE neighbour satisfying pred
+template <typename G>
+static std::optional<SpanningTree> greedy(const G &g) {
+  using Id = typename G::Id;
+
+  SpanningTree tree(g.vertices());
+  if (g.num_verts() == 0)
+    return tree;
 
   // Remaining vertices to add to tree and edges in tree so far
-  std::set<Vertex> todo(vs.begin(), vs.end());
-  std::set<Edge> tes;
-  std::set<Vertex> tvs;
+  std::set<Id> todo;
+  for (Id u = 0; u < g.num_verts(); ++u) {
+    todo.insert(u);
+  }
+  std::vector<bool> added(g.num_verts());
+
+  auto in_todo = [&added](Id v) { return !added[v]; };
+  auto in_tree = [&added](Id v) { return added[v]; };
 
   // Start with naive tree of interval with leftmost right endpoint (LRE)
   // Invariant: prev is always a leaf in the tree
-  Vertex prev = *todo.begin();
+  Id prev = *todo.begin();
   todo.erase(todo.begin());
-  tvs.insert(prev);
+  added[prev] = true;
 
   // While there are vertices not yet in tree
   while (!todo.empty()) {
     // Select adjacent vertex to prev with LRE
-    std::optional<Vertex> curr;
-    for (auto v : adjlist[prev]) {
-      if (todo.count(v)) {
-        curr = v;
-        break;
-      }
-    }
-
-    if (curr) {
+    if (auto curr = g.find_neighbour(prev, in_todo)) {
       // Greedily attach curr to leaf, making prev internal (unless root)
-      tvs.insert(curr.value());
-      tes.insert(Edge(prev, curr.value()));
+      tree.add_edge(prev, curr.value());
       todo.erase(curr.value());
+      added[curr.value()] = true;
       prev = curr.value();
     } else {
       // Pick LRE interval not in tree that can be connected to tree
@@ -59,24 +56,29 @@ std::optional<Graph> interval_mist_greedy(Graph g) {
       // Must not be able to be connected via leaf (since no leaf took it)
       // Increases number of leaves, since it must branch off internal
       bool done = false;
-      for (auto u : todo) {
-        for (auto v : adjlist[u]) {
-          if (!todo.count(v)) {
-            tvs.insert(u);
-            tes.insert(Edge(u, v));
-            todo.erase(u);
-            prev = u;
-            done = true;
-            break;
-          }
-        }
-        if (done)
+      for (Id u : todo) {
+        if (auto v = g.find_neighbour(u, in_tree)) {
+          tree.add_edge(u, v.value());
+          todo.erase(u);
+          added[u] = true;
+          prev = u;
+          done = true;
           break;
+        }
       }
+      // Disconnected, no spanning tree exists
+      if (!done)
+        return {};
     }
 
     if constexpr (featureAssertPrefixProperty) {
-      Graph t(tvs, tes);
+      std::set<Vertex> tvs;
+      for (Id u = 0; u < g.num_verts(); ++u) {
+        if (added[u])
+          tvs.insert(g.vertex(u));
+      }
+      Graph t = tree.to_graph();
+      t.verts = tvs;
       auto tg = Graph::interval_graph_from_set(tvs);
       assert(t.is_spanning_tree_of(tvs));
       auto mist_dp = interval_mist::solvers::dp::interval_mist_dp(tg).value();
@@ -85,16 +87,109 @@ std::optional<Graph> interval_mist_greedy(Graph g) {
   }
 
   if constexpr (featureAssertRootLeafProperty) {
-    auto root = *vs.begin();
-    size_t root_degree = 0;
-    for (Edge e : tes) {
-      if (e.src == root || e.dst == root)
-        ++root_degree;
+    assert(g.num_verts() == 1 || tree.degree(0) == 1);
+  }
+
+  return tree;
+}
+
+std::optional<SpanningTree> interval_mist_greedy(Graph g) {
+  return greedy(CompactGraph(g));
+}
+
+std::optional<SpanningTree> interval_mist_greedy(const IntervalGraph &g) {
+  return greedy(g);
+}
+
+std::optional<SpanningTree> interval_mist_greedy(const CompactGraph &g) {
+  return greedy(g);
+}
+
+// Sorted greedy over intervals exposing size() and operator[], so that both
+// spans and separate endpoint arrays are read in place
+template <typename Intervals>
+static std::optional<SpanningTree> greedy_sorted(const Intervals &is) {
+  using interval_mist::interval::first_upper_at_least;
+  using interval_mist::interval::LowerTree;
+
+  size_t n = is.size();
+  std::vector<Vertex> vs;
+  vs.reserve(n);
+  for (size_t u = 0; u < n; ++u) {
+    assert(u == 0 || is[u - 1] < is[u]);
+    vs.push_back(is[u]);
+  }
+  SpanningTree result(std::move(vs));
+  if (n == 0)
+    return result;
+
+  // Vertices not yet in the tree
+  LowerTree todo(is);
+  // Vertices in the tree
+  LowerTree tree(n);
+  // Vertices not in the tree and not adjacent to anything in it
+  LowerTree unreached(is);
+  // Vertices not in the tree but adjacent to something in it
+  std::set<size_t> attachable;
+
+  // First vertex in ts adjacent to u, by canonical order
+  auto lre_neighbour = [&is](const LowerTree &ts, size_t u) {
+    return ts.first_at_most(first_upper_at_least(is, is[u].lower),
+                            is[u].upper);
+  };
+
+  auto add = [&](size_t u) {
+    todo.erase(u);
+    unreached.erase(u);
+    attachable.erase(u);
+    tree.insert(u, is[u].lower);
+    // Everything unreached that u meets can now attach to the tree
+    for (size_t v = lre_neighbour(unreached, u); v < n;
+         v = unreached.first_at_most(v + 1, is[u].upper)) {
+      unreached.erase(v);
+      attachable.insert(v);
+    }
+  };
+
+  // Start with naive tree of interval with leftmost right endpoint (LRE)
+  // Invariant: prev is always a leaf in the tree
+  size_t prev = 0;
+  add(prev);
+
+  for (size_t added = 1; added < n; ++added) {
+    // Select adjacent vertex to prev with LRE
+    if (size_t curr = lre_neighbour(todo, prev); curr < n) {
+      // Greedily attach curr to leaf, making prev internal (unless root)
+      result.add_edge(prev, curr);
+      add(curr);
+      prev = curr;
+    } else {
+      // Pick LRE interval not in tree that can be connected to tree
+      // Connect to tree via LRE neighbour in tree
+      if (attachable.empty())
+        return {};
+      size_t u = *attachable.begin();
+      result.add_edge(u, lre_neighbour(tree, u));
+      add(u);
+      prev = u;
     }
-    assert(root_degree == 1);
   }
 
-  return {{vs, tes}};
+  if constexpr (featureAssertRootLeafProperty) {
+    assert(n == 1 || result.degree(0) == 1);
+  }
+
+  return result;
+}
+
+std::optional<SpanningTree>
+interval_mist_greedy_sorted(std::span<const Interval> is) {
+  return greedy_sorted(is);
+}
+
+std::optional<SpanningTree>
+interval_mist_greedy_sorted(const IntervalArrays &is) {
+  return greedy_sorted(is);
 }
 
 } // namespace interval_mist::solvers::greedy
\ No newline at end of file
@@ -1,13 +1,38 @@
 #pragma once
 
+#include "../compact_graph.hpp"
 #include "../graph.hpp"
+#include "../interval.hpp"
+#include "../interval_graph.hpp"
+#include "../spanning_tree.hpp"
 
 #include <optional>
+#include <span>
 
 namespace interval_mist::solvers::greedy {
 
+using CompactGraph = interval_mist::graph::CompactGraph;
 using Graph = interval_mist::graph::Graph;
+using Interval = interval_mist::interval::Interval;
+using IntervalArrays = interval_mist::interval::IntervalArrays;
+using IntervalGraph = interval_mist::graph::IntervalGraph;
+using SpanningTree = interval_mist::graph::SpanningTree;
 
-std::optional<Graph> interval_mist_greedy(Graph g);
+std::optional<SpanningTree> interval_mist_greedy(Graph g);
+
+std::optional<SpanningTree> interval_mist_greedy(const IntervalGraph &g);
+
+std::optional<SpanningTree> interval_mist_greedy(const CompactGraph &g);
+
+// Same greedy computed directly from the intervals, which must be distinct and
+// sorted in canonical order, in O(n log n) time and O(n) memory without
+// constructing any edges of the interval graph
+std::optional<SpanningTree>
+interval_mist_greedy_sorted(std::span<const Interval> is);
+
+// As above, reading endpoints in place from separate arrays, such as a file
+// mapped by io::binary
+std::optional<SpanningTree>
+interval_mist_greedy_sorted(const IntervalArrays &is);
 
 } // namespace interval_mist::solvers::greedy
\ No newline at end of file
@@ -0,0 +1,253 @@
+#include "greedy_stream.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+#include <vector>
+
+namespace interval_mist::solvers::greedy {
+
+using Edge = GreedyStream::Edge;
+
+// Past every coordinate, so everything is final once input is finished
+static constexpr uint64_t end_of_input = uint64_t(1) << 32;
+
+// Least interval in canonical order ending no earlier than c
+static Interval upper_at_least(Interval::Coord c) { return Interval(0, c); }
+
+GreedyStream::GreedyStream(Sink sink) : sink(std::move(sink)) {}
+
+bool GreedyStream::push(Interval v) {
+  if (failed || finished || v.lower < sweep)
+    return failed = true, false;
+
+  // Settle everything that no interval starting at or after v could change
+  sweep = v.lower;
+  advance();
+  // The tree can no longer grow, so v can never join it
+  if (failed || (prev && stuck && open.empty() && attachable.empty()))
+    return failed = true, false;
+
+  // Open tree vertices all start by the sweep and end no earlier, so meet v,
+  // and the first is the least
+  pending.emplace(v, std::nullopt);
+  candidates.insert(v, v.lower);
+  if (open.empty()) {
+    unreached.emplace(v.lower, v);
+  } else {
+    set_best(v, *open.begin());
+  }
+  ++verts;
+  peak = std::max(peak, num_retained());
+
+  advance();
+  return !failed;
+}
+
+bool GreedyStream::finish() {
+  if (failed)
+    return false;
+  finished = true;
+  sweep = end_of_input;
+  advance();
+  if (!pending.empty())
+    failed = true;
+  return !failed;
+}
+
+size_t GreedyStream::num_verts() const { return verts; }
+
+size_t GreedyStream::num_edges() const { return edges; }
+
+size_t GreedyStream::num_leaves() const { return leaves; }
+
+size_t GreedyStream::num_internal() const { return internal; }
+
+size_t GreedyStream::num_retained() const { return pending.size() + tree.size(); }
+
+size_t GreedyStream::max_retained() const { return peak; }
+
+size_t GreedyStream::num_probes() const {
+  return candidates.num_visited() + by_best.num_visited();
+}
+
+// Any interval still to come starts at or after sweep, so sorts no earlier
+// than [sweep, sweep] in canonical order. A pending candidate is therefore
+// final once it ends by the sweep, since nothing later can precede it.
+void GreedyStream::advance() {
+  while (!failed) {
+    // Tree vertices ending before the sweep can meet nothing still to come
+    while (!open.empty() && open.begin()->upper < sweep) {
+      Interval t = *open.begin();
+      open.erase(open.begin());
+      release(t);
+    }
+
+    if (!prev) {
+      // Root the tree at the interval with leftmost right endpoint (LRE)
+      if (pending.empty() || pending.begin()->first.upper > sweep)
+        return;
+      attach(pending.begin()->first, {});
+      continue;
+    }
+
+    if (!stuck) {
+      // Later intervals can only meet prev if they start before it ends
+      bool final = prev->upper < sweep;
+      if (auto curr = path_candidate()) {
+        if (!final && curr->upper > sweep)
+          return;
+        // Greedily attach curr to leaf, making prev internal (unless root)
+        attach(curr.value(), prev);
+        continue;
+      }
+      if (!final)
+        return;
+      stuck = true;
+    }
+
+    // Pick LRE interval not in tree that can be connected to tree, and
+    // connect it via its LRE neighbour in tree. A later interval can only be
+    // attachable if some tree vertex is still open.
+    if (attachable.empty()) {
+      if (open.empty() && !pending.empty())
+        failed = true;
+      return;
+    }
+    Interval u = *attachable.begin();
+    if (u.upper > sweep && !open.empty())
+      return;
+    attach(u, pending.at(u));
+    stuck = false;
+  }
+}
+
+// LRE pending neighbour of prev: the first pending interval in canonical order
+// that ends no earlier than prev starts and starts no later than it ends
+std::optional<Interval> GreedyStream::path_candidate() const {
+  return candidates.first_at_most(upper_at_least(prev->lower), prev->upper);
+}
+
+void GreedyStream::attach(Interval v, std::optional<Interval> parent) {
+  auto it = pending.find(v);
+  assert(it != pending.end());
+  std::optional<Interval> best = it->second;
+  pending.erase(it);
+  candidates.erase(v);
+  if (best) {
+    attachable.erase(v);
+    by_best.erase({best.value(), v});
+  } else {
+    unreached.erase({v.lower, v});
+  }
+
+  tree.emplace(v, TreeVertex());
+  if (v.upper >= sweep) {
+    open.insert(v);
+    acquire(v);
+  }
+
+  // v is a better attachment point for those it meets with a later LRE tree
+  // neighbour. v is the root, the least pending interval meeting prev, or the
+  // least attachable one, so none of those ends before v starts, and starting
+  // by the end of v is enough. Each is moved behind the search once found.
+  std::pair<Interval, Interval> from(v, Interval(0, 0));
+  while (auto entry = by_best.first_at_most(from, v.upper)) {
+    from = entry.value();
+    assert(from.second.intersects(v));
+    set_best(from.second, v);
+  }
+  // Pending intervals starting by the end of v but right of the rest of the
+  // tree are reached by v
+  while (!unreached.empty() && unreached.begin()->first <= v.upper) {
+    Interval u = unreached.begin()->second;
+    unreached.erase(unreached.begin());
+    set_best(u, v);
+  }
+
+  if (parent)
+    connect(parent.value(), v);
+  set_prev(v);
+  // Only dropped now so that the parent outlives connect
+  if (best)
+    release(best.value());
+}
+
+void GreedyStream::set_best(Interval u, Interval t) {
+  std::optional<Interval> &best = pending.at(u);
+  if (best) {
+    by_best.erase({best.value(), u});
+    release(best.value());
+  } else {
+    attachable.insert(u);
+  }
+  best = t;
+  by_best.insert({t, u}, u.lower);
+  acquire(t);
+}
+
+void GreedyStream::connect(Interval u, Interval v) {
+  for (Interval w : {u, v}) {
+    size_t &degree = tree.at(w).degree;
+    if (degree == 0) {
+      ++leaves;
+    } else if (degree == 1) {
+      --leaves;
+      ++internal;
+    }
+    ++degree;
+  }
+  ++edges;
+  sink(Edge(u, v));
+}
+
+void GreedyStream::set_prev(Interval v) {
+  acquire(v);
+  if (prev)
+    release(prev.value());
+  prev = v;
+}
+
+void GreedyStream::acquire(Interval v) { ++tree.at(v).refs; }
+
+void GreedyStream::release(Interval v) {
+  auto it = tree.find(v);
+  if (--it->second.refs == 0)
+    tree.erase(it);
+}
+
+std::optional<StreamSummary>
+interval_mist_greedy_stream(std::function<std::optional<Interval>()> next,
+                            GreedyStream::Sink sink) {
+  GreedyStream stream(std::move(sink));
+  while (auto v = next()) {
+    if (!stream.push(v.value()))
+      return {};
+  }
+  if (!stream.finish())
+    return {};
+  return StreamSummary{
+      .num_verts = stream.num_verts(),
+      .num_leaves = stream.num_leaves(),
+      .num_internal = stream.num_internal(),
+      .max_retained = stream.max_retained(),
+  };
+}
+
+std::optional<SpanningTree>
+interval_mist_greedy_stream(std::span<const Interval> is) {
+  std::vector<Interval> by_lower(is.begin(), is.end());
+  std::sort(by_lower.begin(), by_lower.end(),
+            [](const Interval &a, const Interval &b) {
+              return std::pair(a.lower, a.upper) < std::pair(b.lower, b.upper);
+            });
+  SpanningTree tree(std::vector<Interval>(is.begin(), is.end()));
+  auto summary = interval_mist_greedy_stream(
+      by_lower.begin(), by_lower.end(),
+      [&tree](const Edge &e) { tree.add_edge(e.src, e.dst); });
+  if (!summary)
+    return {};
+  return tree;
+}
+
+} // namespace interval_mist::solvers::greedy
@@ -0,0 +1,146 @@
+#pragma once
+
+#include "../graph.hpp"
+#include "../interval.hpp"
+#include "../lower_tree.hpp"
+#include "../spanning_tree.hpp"
+
+#include <functional>
+#include <map>
+#include <optional>
+#include <set>
+#include <span>
+
+namespace interval_mist::solvers::greedy {
+
+using Graph = interval_mist::graph::Graph;
+using Interval = interval_mist::interval::Interval;
+using SpanningTree = interval_mist::graph::SpanningTree;
+
+// Incremental form of interval_mist_greedy for inputs too large to hold in
+// memory. Intervals are fed in nondecreasing order of left endpoint, which is
+// the order a left to right sweep opens them, and each tree edge is passed to
+// the sink as soon as no later interval could change it. Only intervals still
+// open at the sweep position, or not yet attached to the tree, are retained.
+//
+// Right endpoint order would not work here: a later interval can start
+// arbitrarily far to the left, so no decision could ever be made final.
+struct GreedyStream {
+  using Edge = Graph::Edge;
+  using Sink = std::function<void(const Edge &)>;
+
+  GreedyStream(Sink sink);
+
+  // Feed the next interval. Intervals must be distinct and arrive in
+  // nondecreasing order of left endpoint. Returns false if the interval is out
+  // of order or can no longer be connected to the tree.
+  bool push(Interval);
+
+  // Signal end of input and emit the remaining edges. Returns false if the
+  // intervals did not form a connected graph.
+  bool finish();
+
+  size_t num_verts() const;
+
+  size_t num_edges() const;
+
+  // Leaves and internal vertices of the tree emitted so far
+  size_t num_leaves() const;
+
+  size_t num_internal() const;
+
+  // Intervals currently held, and the most held at any one time
+  size_t num_retained() const;
+
+  size_t max_retained() const;
+
+  // Index entries visited finding path candidates and better attachment
+  // points, which grows as O(log retained) per interval
+  size_t num_probes() const;
+
+private:
+  struct TreeVertex {
+    size_t degree = 0;
+    // Reasons to keep this vertex: open at the sweep, being prev, or being the
+    // best attachment point of a pending interval
+    size_t refs = 0;
+  };
+
+  Sink sink;
+
+  // Lower bound on left endpoints still to come, or above every coordinate
+  // once input is finished
+  uint64_t sweep = 0;
+  bool finished = false;
+  bool failed = false;
+
+  // Intervals not yet in the tree, with their LRE tree neighbour if any, and
+  // the same indexed by left endpoint
+  std::map<Interval, std::optional<Interval>> pending;
+  interval::LowerSet<Interval> candidates;
+  // Pending intervals adjacent to the tree, and the same keyed by their LRE
+  // tree neighbour and indexed by their own left endpoint
+  std::set<Interval> attachable;
+  interval::LowerSet<std::pair<Interval, Interval>> by_best;
+  // Pending intervals not adjacent to the tree by left endpoint. The tree
+  // covers a contiguous range, and these all start to its right.
+  std::set<std::pair<Interval::Coord, Interval>> unreached;
+  // Tree vertices that later intervals may still meet
+  std::set<Interval> open;
+  // Tree vertices that may still gain edges
+  std::map<Interval, TreeVertex> tree;
+
+  // Last vertex attached, and whether it has no pending neighbour left
+  std::optional<Interval> prev;
+  bool stuck = false;
+
+  size_t verts = 0, edges = 0, leaves = 0, internal = 0;
+  size_t peak = 0;
+
+  void advance();
+
+  // Move v from pending into the tree, joined to parent, and make it prev
+  void attach(Interval v, std::optional<Interval> parent);
+
+  void set_best(Interval u, Interval t);
+
+  void connect(Interval, Interval);
+
+  void set_prev(Interval);
+
+  void acquire(Interval);
+
+  void release(Interval);
+
+  std::optional<Interval> path_candidate() const;
+};
+
+struct StreamSummary {
+  size_t num_verts, num_leaves, num_internal, max_retained;
+};
+
+// Run GreedyStream over intervals produced by next until it returns nullopt
+std::optional<StreamSummary>
+interval_mist_greedy_stream(std::function<std::optional<Interval>()> next,
+                            GreedyStream::Sink sink);
+
+// Run GreedyStream over an input range
+template <typename It>
+std::optional<StreamSummary>
+interval_mist_greedy_stream(It begin, It end, GreedyStream::Sink sink) {
+  return interval_mist_greedy_stream(
+      [&begin, end]() -> std::optional<Interval> {
+        if (begin == end)
+          return {};
+        return *begin++;
+      },
+      sink);
+}
+
+// Feed intervals, which must be distinct and in canonical order, to
+// GreedyStream in order of left endpoint, collecting the emitted edges into a
+// spanning tree
+std::optional<SpanningTree>
+interval_mist_greedy_stream(std::span<const Interval> is);
+
+} // namespace interval_mist::solvers::greedy
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include "../generators/intervals.hpp"
+#include "../spanning_tree.hpp"
+#include "greedy.hpp"
+#include "greedy_stream.hpp"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace interval_mist::solvers::greedy {
+
+namespace intervals = generators::intervals;
+
+using SpanningTree = interval_mist::graph::SpanningTree;
+
+// Streams is, which is in canonical order, in sweep order, collecting the
+// emitted edges into a tree
+static std::optional<SpanningTree> stream(const std::vector<Interval> &is,
+                                          StreamSummary *summary = nullptr) {
+  std::vector<Interval> sweep = is;
+  std::sort(sweep.begin(), sweep.end(), [](Interval a, Interval b) {
+    return std::pair(a.lower, a.upper) < std::pair(b.lower, b.upper);
+  });
+  SpanningTree tree(is);
+  auto result = interval_mist_greedy_stream(
+      sweep.begin(), sweep.end(),
+      [&tree](const GreedyStream::Edge &e) { tree.add_edge(e.src, e.dst); });
+  if (!result)
+    return {};
+  if (summary)
+    *summary = result.value();
+  return tree;
+}
+
+TEST(GreedyStreamTest, Disconnected) {
+  EXPECT_FALSE(stream({Interval(0, 1), Interval(2, 3)}));
+}
+
+TEST(GreedyStreamTest, OutOfOrder) {
+  GreedyStream gs([](const GreedyStream::Edge &) {});
+  EXPECT_TRUE(gs.push(Interval(2, 5)));
+  EXPECT_FALSE(gs.push(Interval(0, 3)));
+}
+
+TEST(GreedyStreamTest, MatchesSortedGreedy) {
+  for (intervals::Family family : intervals::families) {
+    for (size_t num : {1, 2, 3, 10, 50, 300}) {
+      for (size_t seed = 0; seed < 5; ++seed) {
+        auto is = intervals::generate(family, seed, num);
+        SCOPED_TRACE(intervals::name(family) + " " + std::to_string(num) +
+                     " " + std::to_string(seed));
+        StreamSummary summary;
+        auto actual = stream(is, &summary);
+        auto expected = interval_mist_greedy_sorted(is);
+        ASSERT_TRUE(expected.has_value());
+        ASSERT_TRUE(actual.has_value());
+        EXPECT_TRUE(actual->is_spanning_tree_of(is));
+        EXPECT_EQ(expected->num_leaves(), actual->num_leaves());
+        EXPECT_EQ(expected->to_graph(), actual->to_graph());
+        EXPECT_EQ(num, summary.num_verts);
+        EXPECT_EQ(actual->num_leaves(), summary.num_leaves);
+        EXPECT_EQ(actual->num_internal(), summary.num_internal);
+      }
+    }
+  }
+}
+
+TEST(GreedyStreamTest, RetainsOnlyTheFrontier) {
+  // Unit intervals of length 8 never have more than a few open at once
+  auto is = intervals::unit(3, 10000);
+  StreamSummary summary;
+  ASSERT_TRUE(stream(is, &summary));
+  EXPECT_LT(summary.max_retained, 100);
+}
+
+TEST(GreedyStreamTest, WideCliqueCostsLogarithmic) {
+  // Staggered and nested cliques keep every interval retained at once, yet
+  // each step searches only O(log n) index entries
+  const size_t num = 1 << 14, log_num = 14;
+  for (bool nested : {false, true}) {
+    SCOPED_TRACE(nested ? "nested" : "staggered");
+    GreedyStream gs([](const GreedyStream::Edge &) {});
+    for (Interval::Coord i = 0; i < num; ++i) {
+      ASSERT_TRUE(gs.push(nested ? Interval(i, 2 * num - i)
+                                 : Interval(i, num + i)));
+    }
+    ASSERT_TRUE(gs.finish());
+    EXPECT_GT(gs.max_retained(), num / 2);
+    EXPECT_LT(gs.num_probes(), 4 * log_num * num);
+  }
+}
+
+} // namespace interval_mist::solvers::greedy
@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+
+#include "../generators/intervals.hpp"
+#include "greedy.hpp"
+
+#include <set>
+#include <vector>
+
+namespace interval_mist::solvers::greedy {
+
+namespace intervals = generators::intervals;
+
+TEST(GreedyTest, SortedEmpty) {
+  auto expected = interval_mist_greedy(Graph::interval_graph_from_set({}));
+  auto actual = interval_mist_greedy_sorted(std::vector<Interval>());
+  ASSERT_EQ(expected.has_value(), actual.has_value());
+  if (actual) {
+    EXPECT_EQ(0, actual->num_verts());
+  }
+}
+
+TEST(GreedyTest, SortedDisconnected) {
+  std::vector<Interval> is = {Interval(0, 1), Interval(1, 2), Interval(3, 4)};
+  EXPECT_FALSE(interval_mist_greedy_sorted(is));
+}
+
+TEST(GreedyTest, SortedMatchesGraphGreedy) {
+  for (intervals::Family family : intervals::families) {
+    for (size_t num : {1, 2, 3, 10, 50, 300}) {
+      for (size_t seed = 0; seed < 5; ++seed) {
+        auto is = intervals::generate(family, seed, num);
+        SCOPED_TRACE(intervals::name(family) + " " + std::to_string(num) +
+                     " " + std::to_string(seed));
+        auto expected = interval_mist_greedy(
+            Graph::interval_graph_from_set(std::set(is.begin(), is.end())));
+        auto actual = interval_mist_greedy_sorted(is);
+        ASSERT_TRUE(expected.has_value());
+        ASSERT_TRUE(actual.has_value());
+        EXPECT_TRUE(actual->is_spanning_tree_of(is));
+        EXPECT_EQ(expected->num_leaves(), actual->num_leaves());
+        EXPECT_EQ(expected->to_graph(), actual->to_graph());
+      }
+    }
+  }
+}
+
+TEST(GreedyTest, SortedArraysMatchSpan) {
+  auto is = intervals::generate(intervals::Family::long_tailed, 7, 500);
+  std::vector<Interval::Coord> lower, upper;
+  for (Interval i : is) {
+    lower.push_back(i.lower);
+    upper.push_back(i.upper);
+  }
+  auto expected = interval_mist_greedy_sorted(is);
+  auto actual = interval_mist_greedy_sorted(IntervalArrays{lower, upper});
+  ASSERT_TRUE(expected.has_value());
+  ASSERT_TRUE(actual.has_value());
+  EXPECT_EQ(expected->to_graph(), actual->to_graph());
+}
+
+} // namespace interval_mist::solvers::greedy
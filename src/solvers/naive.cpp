@@ -1,46 +1,273 @@
 #include "naive.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <limits>
-#include <set>
-#include <stack>
 #include <utility>
 #include <vector>
 
 namespace interval_mist::solvers::naive {
 
-using Vertex = Graph::Vertex;
-using Edge = Graph::Edge;
-
-std::optional<Graph> interval_mist_naive(Graph g) {
-  size_t best_leaves = std::numeric_limits<size_t>::max();
-  std::optional<Graph> best;
-
-  auto [vs, es] = g;
-  size_t limit = vs.size() - 1;
-  std::vector<Edge> edges(es.begin(), es.end());
-
-  std::stack<std::pair<std::set<Edge>, size_t>> s;
-  s.push(make_pair(std::set<Edge>(), 0));
-  while (!s.empty()) {
-    auto [es_prime, i] = s.top();
-    s.pop();
-    if (es_prime.size() == limit) {
-      auto g_prime = Graph(vs, es_prime);
-      if (g_prime.is_spanning_tree_of(g.verts)) {
-        size_t leaves = g_prime.num_leaves();
-        if (leaves < best_leaves) {
-          best_leaves = leaves;
-          best = g_prime;
-        }
+using Id = CompactGraph::Id;
+
+static constexpr size_t unbounded = std::numeric_limits<size_t>::max();
+
+// Union-find by size without path compression, so the last union can be undone
+struct UnionFind {
+  std::vector<Id> parent;
+  std::vector<size_t> size;
+  std::vector<Id> history;
+
+  UnionFind(size_t n) : parent(n), size(n, 1) {
+    for (Id u = 0; u < n; ++u) {
+      parent[u] = u;
+    }
+  }
+
+  Id find(Id u) const {
+    while (parent[u] != u) {
+      u = parent[u];
+    }
+    return u;
+  }
+
+  // Returns false without change if u and v are already connected
+  bool unite(Id u, Id v) {
+    u = find(u);
+    v = find(v);
+    if (u == v)
+      return false;
+    if (size[u] < size[v])
+      std::swap(u, v);
+    parent[v] = u;
+    size[u] += size[v];
+    history.push_back(v);
+    return true;
+  }
+
+  void undo() {
+    Id v = history.back();
+    history.pop_back();
+    size[parent[v]] -= size[v];
+    parent[v] = v;
+  }
+};
+
+// Depth first search over edge subsets, deciding to include each edge (if it
+// joins two components) before excluding it. Trees are reached in the same
+// order as by enumerating subsets, and only strictly fewer leaves replace the
+// best, so pruning never changes which tree is found.
+struct Search {
+  const std::vector<std::pair<Id, Id>> &edges;
+  size_t num_verts;
+
+  UnionFind uf;
+  std::vector<size_t> degree;
+  // Degree each vertex would reach if every undecided edge were included
+  std::vector<size_t> reach;
+  // Vertices reaching degree at most 1 are sure to be leaves, or to be
+  // isolated if they reach 0
+  size_t sure_leaves = 0, isolated = 0;
+  // Sum over vertices of degree beyond 2. A tree has exactly 2 more leaves
+  // than this, and degrees only grow, so it bounds the leaves from below.
+  size_t excess = 0;
+  std::vector<size_t> chosen;
+
+  size_t best_leaves = unbounded;
+  std::vector<size_t> best;
+  // Fewest leaves found by any search, so other threads' trees can prune ours
+  std::atomic<size_t> *shared_best = nullptr;
+
+  Search(const std::vector<std::pair<Id, Id>> &edges, size_t num_verts)
+      : edges(edges), num_verts(num_verts), uf(num_verts),
+        degree(num_verts, 0), reach(num_verts, 0) {
+    for (auto [u, v] : edges) {
+      ++reach[u];
+      ++reach[v];
+    }
+    for (size_t r : reach) {
+      sure_leaves += r <= 1;
+      isolated += r == 0;
+    }
+  }
+
+  void lower_reach(Id u) {
+    size_t r = --reach[u];
+    sure_leaves += r == 1;
+    isolated += r == 0;
+  }
+
+  void raise_reach(Id u) {
+    size_t r = reach[u]++;
+    sure_leaves -= r == 1;
+    isolated -= r == 0;
+  }
+
+  bool include(size_t i) {
+    auto [u, v] = edges[i];
+    if (!uf.unite(u, v))
+      return false;
+    excess += (++degree[u] > 2) + (++degree[v] > 2);
+    chosen.push_back(i);
+    return true;
+  }
+
+  void undo_include(size_t i) {
+    auto [u, v] = edges[i];
+    excess -= (degree[u]-- > 2) + (degree[v]-- > 2);
+    chosen.pop_back();
+    uf.undo();
+  }
+
+  void exclude(size_t i) {
+    lower_reach(edges[i].first);
+    lower_reach(edges[i].second);
+  }
+
+  void undo_exclude(size_t i) {
+    raise_reach(edges[i].first);
+    raise_reach(edges[i].second);
+  }
+
+  bool pruned(size_t i) const {
+    size_t needed = num_verts - 1 - chosen.size();
+    if (needed > edges.size() - i || (num_verts > 1 && isolated > 0))
+      return true;
+    size_t min_leaves = std::max(sure_leaves, excess + 2);
+    if (min_leaves >= best_leaves)
+      return true;
+    return shared_best && min_leaves > shared_best->load();
+  }
+
+  void record() {
+    size_t leaves = 0;
+    for (size_t d : degree) {
+      leaves += d == 1;
+    }
+    if (leaves < best_leaves) {
+      best_leaves = leaves;
+      best = chosen;
+    }
+    if (shared_best) {
+      size_t curr = shared_best->load();
+      while (leaves < curr &&
+             !shared_best->compare_exchange_weak(curr, leaves)) {
+      }
+    }
+  }
+
+  // Decide edges from i onwards
+  void run(size_t i) {
+    if (chosen.size() == num_verts - 1) {
+      record();
+      return;
+    }
+    if (pruned(i))
+      return;
+
+    // Include edge i, leaving its endpoints' reach as is
+    if (include(i)) {
+      run(i + 1);
+      undo_include(i);
+    }
+
+    exclude(i);
+    run(i + 1);
+    undo_exclude(i);
+  }
+};
+
+static std::vector<std::pair<Id, Id>> edge_list(const CompactGraph &g) {
+  std::vector<std::pair<Id, Id>> edges;
+  for (Id u = 0; u < g.num_verts(); ++u) {
+    for (Id v : g.neighbours(u)) {
+      if (u < v)
+        edges.emplace_back(u, v);
+    }
+  }
+  return edges;
+}
+
+static SpanningTree tree_of(const CompactGraph &g,
+                            const std::vector<std::pair<Id, Id>> &edges,
+                            const std::vector<size_t> &chosen) {
+  SpanningTree tree(g.vertices());
+  for (size_t i : chosen) {
+    auto [u, v] = edges[i];
+    tree.add_edge(u, v);
+  }
+  return tree;
+}
+
+std::optional<SpanningTree> interval_mist_naive(const CompactGraph &g) {
+  if (g.num_verts() == 0)
+    return {};
+
+  auto edges = edge_list(g);
+  Search search(edges, g.num_verts());
+  search.run(0);
+  if (search.best_leaves == unbounded)
+    return {};
+  return tree_of(g, edges, search.best);
+}
+
+std::optional<SpanningTree>
+interval_mist_naive(const CompactGraph &g, thread_pool::ThreadPool &pool) {
+  if (g.num_verts() == 0)
+    return {};
+
+  auto edges = edge_list(g);
+
+  // Split the search tree by the decisions on its first few edges, giving
+  // some tasks per thread, each a list of edges included or excluded
+  std::vector<std::vector<bool>> prefixes = {{}};
+  while (prefixes.size() < 16 * pool.num_threads() &&
+         prefixes.front().size() < edges.size()) {
+    std::vector<std::vector<bool>> next;
+    for (auto &prefix : prefixes) {
+      for (bool take : {true, false}) {
+        next.push_back(prefix);
+        next.back().push_back(take);
+      }
+    }
+    prefixes = std::move(next);
+  }
+
+  // Each task keeps the first tree with the fewest leaves in its part of the
+  // search tree, pruning only by strictly fewer leaves found elsewhere, so the
+  // first task to find an optimal tree finds the same one as a serial search
+  std::atomic<size_t> shared_best = unbounded;
+  std::vector<std::optional<Search>> searches(prefixes.size());
+  pool.parallel_for(prefixes.size(), [&](size_t t) {
+    Search &search = searches[t].emplace(edges, g.num_verts());
+    search.shared_best = &shared_best;
+    for (size_t i = 0; i < prefixes[t].size(); ++i) {
+      if (search.chosen.size() == g.num_verts() - 1) {
+        // Already a tree, so only the prefix excluding everything else counts
+        if (prefixes[t][i])
+          return;
+      } else if (prefixes[t][i]) {
+        if (!search.include(i))
+          return;
+      } else {
+        search.exclude(i);
       }
-    } else if (es_prime.size() < limit && i < edges.size()) {
-      s.push(make_pair(es_prime, i + 1));
-      es_prime.insert(edges[i]);
-      s.push(make_pair(es_prime, i + 1));
     }
+    search.run(prefixes[t].size());
+  });
+
+  const Search *best = nullptr;
+  for (auto &search : searches) {
+    if (search && (!best || search->best_leaves < best->best_leaves))
+      best = &search.value();
   }
+  if (!best || best->best_leaves == unbounded)
+    return {};
+  return tree_of(g, edges, best->best);
+}
 
-  return best;
+std::optional<SpanningTree> interval_mist_naive(Graph g) {
+  return interval_mist_naive(CompactGraph(g));
 }
 
-} // namespace interval_mist::solvers::naive
\ No newline at end of file
+} // namespace interval_mist::solvers::naive
@@ -1,13 +1,24 @@
 #pragma once
 
+#include "../compact_graph.hpp"
 #include "../graph.hpp"
+#include "../spanning_tree.hpp"
+#include "../thread_pool.hpp"
 
 #include <optional>
 
 namespace interval_mist::solvers::naive {
 
+using CompactGraph = interval_mist::graph::CompactGraph;
 using Graph = interval_mist::graph::Graph;
+using SpanningTree = interval_mist::graph::SpanningTree;
 
-std::optional<Graph> interval_mist_naive(Graph g);
+std::optional<SpanningTree> interval_mist_naive(Graph g);
+
+std::optional<SpanningTree> interval_mist_naive(const CompactGraph &g);
+
+// As above, splitting the search across pool. Finds the same tree.
+std::optional<SpanningTree>
+interval_mist_naive(const CompactGraph &g, thread_pool::ThreadPool &pool);
 
 } // namespace interval_mist::solvers::naive
\ No newline at end of file
@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+
+#include "naive.hpp"
+
+#include <numeric>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace interval_mist::solvers::naive {
+
+using Id = CompactGraph::Id;
+using Vertex = Graph::Vertex;
+
+// Every subset of the edges of g, including each edge before excluding it,
+// with no pruning. Keeps the first tree with the fewest leaves, which is the
+// one the pruned search should find.
+struct Unpruned {
+  const CompactGraph &g;
+  std::vector<std::pair<Id, Id>> edges;
+  std::vector<size_t> chosen;
+  std::optional<SpanningTree> best;
+
+  Unpruned(const CompactGraph &g) : g(g) {
+    for (Id u = 0; u < g.num_verts(); ++u) {
+      for (Id v : g.neighbours(u)) {
+        if (u < v)
+          edges.emplace_back(u, v);
+      }
+    }
+    run(0);
+  }
+
+  // Whether the chosen edges form a spanning tree, by union-find
+  bool spanning() const {
+    if (chosen.size() + 1 != g.num_verts())
+      return false;
+    std::vector<Id> uf(g.num_verts());
+    std::iota(uf.begin(), uf.end(), 0);
+    auto find = [&uf](Id u) {
+      while (uf[u] != u) {
+        u = uf[u];
+      }
+      return u;
+    };
+    for (size_t e : chosen) {
+      Id a = find(edges[e].first), b = find(edges[e].second);
+      if (a == b)
+        return false;
+      uf[a] = b;
+    }
+    return true;
+  }
+
+  void run(size_t i) {
+    if (i == edges.size()) {
+      if (!spanning())
+        return;
+      SpanningTree tree(g.vertices());
+      for (size_t e : chosen) {
+        tree.add_edge(edges[e].first, edges[e].second);
+      }
+      if (!best || tree.num_leaves() < best->num_leaves())
+        best = std::move(tree);
+      return;
+    }
+    chosen.push_back(i);
+    run(i + 1);
+    chosen.pop_back();
+    run(i + 1);
+  }
+};
+
+static Graph graph_of(std::set<Vertex> vs) {
+  return Graph::interval_graph_from_set(std::move(vs));
+}
+
+static void expect_same(const std::optional<SpanningTree> &expected,
+                        const std::optional<SpanningTree> &actual) {
+  ASSERT_EQ(expected.has_value(), actual.has_value());
+  if (expected) {
+    EXPECT_EQ(expected->to_graph(), actual->to_graph());
+  }
+}
+
+TEST(NaiveTest, MatchesUnpruned) {
+  for (size_t seed = 0; seed < 200; ++seed) {
+    CompactGraph g(Graph::random_connected_interval_graph(seed, 1 + seed % 8));
+    Unpruned unpruned(g);
+    if (unpruned.edges.size() > 18)
+      continue;
+    expect_same(unpruned.best, interval_mist_naive(g));
+  }
+}
+
+TEST(NaiveTest, SureLeaves) {
+  // Pendant intervals on a long one are leaves in any tree, which bounds the
+  // search from the start
+  CompactGraph g(graph_of({Vertex(0, 10), Vertex(1, 2), Vertex(3, 4),
+                           Vertex(5, 6), Vertex(7, 8), Vertex(9, 12),
+                           Vertex(11, 13)}));
+  auto tree = interval_mist_naive(g);
+  expect_same(Unpruned(g).best, tree);
+  EXPECT_EQ(5, tree->num_leaves());
+}
+
+TEST(NaiveTest, Excess) {
+  // A clique, where every tree is found but those with a high degree vertex
+  // are cut off early
+  std::set<Vertex> vs;
+  for (size_t i = 0; i < 6; ++i) {
+    vs.insert(Vertex(i, 20 - i));
+  }
+  CompactGraph g(graph_of(vs));
+  auto tree = interval_mist_naive(g);
+  expect_same(Unpruned(g).best, tree);
+  EXPECT_EQ(2, tree->num_leaves());
+}
+
+TEST(NaiveTest, Isolated) {
+  CompactGraph g(graph_of({Vertex(0, 2), Vertex(1, 3), Vertex(2, 4),
+                           Vertex(6, 7)}));
+  EXPECT_FALSE(interval_mist_naive(g));
+  EXPECT_FALSE(Unpruned(g).best);
+}
+
+TEST(NaiveTest, ParallelMatchesSerial) {
+  for (size_t threads : {1, 2, 3, 8}) {
+    thread_pool::ThreadPool pool(threads);
+    // Down to graphs with fewer edges than the prefixes split on
+    for (size_t seed = 0; seed < 60; ++seed) {
+      CompactGraph g(
+          Graph::random_connected_interval_graph(seed, 1 + seed % 10));
+      expect_same(interval_mist_naive(g), interval_mist_naive(g, pool));
+    }
+    CompactGraph g(graph_of({Vertex(0, 1), Vertex(2, 3)}));
+    EXPECT_FALSE(interval_mist_naive(g, pool));
+  }
+}
+
+} // namespace interval_mist::solvers::naive
@@ -1,168 +1,261 @@
 #include "path_cover.hpp"
 
-#include <iostream>
-#include <map>
+#include "../interval_array.hpp"
+#include "../lower_tree.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <span>
 
 namespace interval_mist::solvers::path_cover {
 
 using Edge = Graph::Edge;
+using IntervalArray = interval_mist::interval::IntervalArray;
+using LowerTree = interval_mist::interval::LowerTree;
 
-std::vector<std::vector<Vertex>> interval_path_cover(Graph g) {
-  auto [vs, es] = g;
-
-  std::map<Vertex, std::vector<Vertex>> adjlist;
-  for (auto [u, v] : es) {
-    assert(vs.count(u));
-    assert(vs.count(v));
-    adjlist[u].push_back(v);
-    adjlist[v].push_back(u);
-  }
+// Greedy path cover over a graph exposing dense ids in canonical order and a
+// find_neighbour(u, pred) query for the LRE neighbour satisfying pred
+template <typename G>
+static std::vector<std::vector<Vertex>> greedy_path_cover(const G &g) {
+  using Id = typename G::Id;
 
-  for (auto &[k, v] : adjlist) {
-    sort(v.begin(), v.end());
-  }
+  if (g.num_verts() == 0)
+    return {};
 
-  std::set<Vertex> covered;
-  std::set<Vertex> ordered(vs.begin(), vs.end());
-
-  std::vector<std::vector<Vertex>> paths(1);
-  paths.back().push_back(*ordered.begin());
-  covered.insert(paths.back().back());
-  ordered.erase(ordered.begin());
-
-  while (!ordered.empty()) {
-    Vertex curr = paths.back().back();
-    std::optional<Vertex> succ;
-    for (auto v : adjlist[curr]) {
-      if (!covered.count(v)) {
-        succ = v;
-        break;
-      }
-    }
-    if (!succ) {
-      succ = *ordered.begin();
-      paths.push_back(std::vector<Vertex>());
+  std::vector<bool> covered(g.num_verts());
+  auto uncovered = [&covered](Id v) { return !covered[v]; };
+
+  // The LRE uncovered vertex only ever moves right, so track it with next
+  Id next = 0;
+  std::vector<std::vector<Vertex>> paths;
+  for (Id curr = 0;; curr = next) {
+    paths.emplace_back();
+    // Extend by LRE uncovered neighbour until stuck
+    for (std::optional<Id> succ = curr; succ;
+         succ = g.find_neighbour(curr, uncovered)) {
+      curr = succ.value();
+      covered[curr] = true;
+      paths.back().push_back(g.vertex(curr));
     }
-    paths.back().push_back(succ.value());
-    ordered.erase(succ.value());
-    covered.insert(succ.value());
+    // Start a new path at the LRE uncovered vertex
+    while (next < g.num_verts() && covered[next])
+      ++next;
+    if (next == g.num_verts())
+      break;
   }
 
   return paths;
 }
 
-std::set<Edge> path_to_edge_set(std::vector<Vertex> p) {
-  std::set<Edge> result;
-  for (size_t i = 1; i < p.size(); ++i) {
-    result.insert(Edge(p[i - 1], p[i]));
+// The same greedy path cover of the interval graph of verts, which are in
+// canonical order. Only uncovered vertices are kept in the min-tree, so the
+// LRE uncovered neighbour of u is the first from those ending at or after u
+// starts with a left endpoint at most u's right, found in O(log n) however
+// many covered neighbours come before it.
+static std::vector<std::vector<Vertex>>
+sorted_path_cover(std::span<const Vertex> verts) {
+  if (verts.empty())
+    return {};
+
+  LowerTree uncovered(verts);
+  auto next_neighbour = [&](size_t u) {
+    size_t from = interval::first_upper_at_least(verts, verts[u].lower);
+    return uncovered.first_at_most(from, verts[u].upper);
+  };
+
+  size_t next = 0;
+  std::vector<std::vector<Vertex>> paths;
+  for (size_t curr = 0;; curr = next) {
+    paths.emplace_back();
+    for (size_t succ = curr; succ < verts.size();
+         succ = next_neighbour(curr)) {
+      curr = succ;
+      uncovered.erase(curr);
+      paths.back().push_back(verts[curr]);
+    }
+    while (next < verts.size() && !uncovered.contains(next))
+      ++next;
+    if (next == verts.size())
+      break;
   }
-  return result;
+
+  return paths;
 }
 
-std::optional<Graph> interval_mist_path_cover(Graph g) {
-  auto [vs, es] = g;
+std::vector<std::vector<Vertex>> interval_path_cover(Graph g) {
+  return greedy_path_cover(CompactGraph(g));
+}
+
+std::vector<std::vector<Vertex>> interval_path_cover(const IntervalGraph &g) {
+  return sorted_path_cover(g.vertices());
+}
+
+std::vector<std::vector<Vertex>> interval_path_cover(const CompactGraph &g) {
+  return greedy_path_cover(g);
+}
+
+// Join the paths of a path cover of an interval graph into a spanning tree.
+//
+// The tree starts as the last path. A remaining path q can join it once one
+// of its vertices lies strictly between the leftmost and rightmost of the
+// tree in canonical order, or one of the tree's lies strictly between q's,
+// and the first such path in cover order joins next. Both conditions only
+// ever become true as the tree grows, so rather than testing every path on
+// every step, each is found joinable once: by sweeping the vertices the
+// tree's range newly covers, and by asking, for each vertex the tree gains,
+// which remaining paths span it. The latter keeps the paths in a min-tree of
+// their leftmost positions indexed by their rightmost. Everything is
+// O(n log n) in the number of vertices. The one linear scan left, for the
+// vertex of a joining path meeting the tree's leftmost, runs over the path's
+// endpoint arrays with the vector kernels, and sees each path only once.
+static std::optional<SpanningTree>
+mist_from_path_cover(std::vector<std::vector<Vertex>> pc) {
+  if (pc.empty())
+    return SpanningTree(std::vector<Vertex>());
+
+  // Every vertex in canonical order, the path each lies on, and the
+  // positions of each path's vertices in canonical order
+  std::vector<Vertex> verts;
+  for (const auto &p : pc) {
+    verts.insert(verts.end(), p.begin(), p.end());
+  }
+  std::sort(verts.begin(), verts.end());
+  size_t n = verts.size();
+  // Positions double as left endpoints in the min-trees below
+  assert(n < std::numeric_limits<LowerTree::Coord>::max());
+  std::vector<size_t> path_of(n);
+  std::vector<std::vector<size_t>> positions(pc.size());
+  for (size_t p = 0; p < pc.size(); ++p) {
+    for (const Vertex &v : pc[p]) {
+      size_t k = std::lower_bound(verts.begin(), verts.end(), v) -
+                 verts.begin();
+      path_of[k] = p;
+      positions[p].push_back(k);
+    }
+    std::sort(positions[p].begin(), positions[p].end());
+  }
+  std::vector<IntervalArray> arrays(pc.size());
+  for (size_t p = 0; p < pc.size(); ++p) {
+    for (size_t k : positions[p]) {
+      arrays[p].push_back(verts[k]);
+    }
+  }
+
+  // Remaining paths not yet joinable, at their rightmost position
+  LowerTree spans(n);
+  for (size_t p = 0; p + 1 < pc.size(); ++p) {
+    spans.insert(positions[p].back(), positions[p].front());
+  }
+  std::vector<bool> done(pc.size()), joinable(pc.size());
+  std::priority_queue<size_t, std::vector<size_t>, std::greater<>> ready;
+  auto mark = [&](size_t p) {
+    if (done[p] || joinable[p])
+      return;
+    joinable[p] = true;
+    ready.push(p);
+    spans.erase(positions[p].back());
+  };
+
+  // Vertices of the tree, and its edges in no particular order
+  LowerTree tree(n);
+  std::vector<Edge> edges;
+  auto add_path = [&](size_t p) {
+    for (size_t i = 0; i < positions[p].size(); ++i) {
+      size_t k = positions[p][i];
+      tree.insert(k, verts[k].lower);
+      if (i > 0)
+        edges.emplace_back(pc[p][i - 1], pc[p][i]);
+      // Paths whose leftmost is before k and rightmost after
+      for (size_t s; k > 0 && (s = spans.first_at_most(k + 1, k - 1)) < n;) {
+        mark(path_of[s]);
+      }
+    }
+  };
+  auto sweep = [&](size_t begin, size_t end) {
+    for (size_t k = begin; k < end; ++k) {
+      mark(path_of[k]);
+    }
+  };
 
-  // Find a path cover P* of G
-  auto pc = interval_path_cover(g);
-  // std::cerr << "PATH COVER:" << std::endl;
-  // for (auto p : pc) {
-  //   for (auto v : p) {
-  //     std::cerr << "  (" << v.lower << ", " << v.upper << ")";
-  //   }
-  //   std::cerr << std::endl;
-  // }
   // Tc <- {p | p \in P*}, Pc <- P* \ {p}
-  auto tvs = std::set<Vertex>(pc.back().begin(), pc.back().end());
-  auto tes = path_to_edge_set(pc.back());
-  pc.pop_back();
+  done.back() = true;
+  add_path(pc.size() - 1);
+  // Positions of leftMost(Tc) and rightMost(Tc)
+  size_t lmost = positions.back().front(), rmost = positions.back().back();
+  sweep(lmost + 1, rmost);
+
   // while Pc not empty:
-  while (!pc.empty()) {
+  for (size_t remaining = pc.size() - 1; remaining > 0; --remaining) {
     // Choose q from Pc where q intersects Tc
-    auto qit = pc.begin();
-    for (; qit != pc.end(); ++qit) {
-      Vertex tv_lmost = *tvs.begin();
-      Vertex tv_rmost = *tvs.rbegin();
-      if (any_of(qit->begin(), qit->end(), [tv_lmost, tv_rmost](Vertex qv) {
-            return tv_lmost < qv && qv < tv_rmost;
-          }))
-        break;
-
-      Vertex qv_lmost = *min_element(qit->begin(), qit->end());
-      Vertex qv_rmost = *max_element(qit->begin(), qit->end());
-      if (any_of(tvs.begin(), tvs.end(), [qv_lmost, qv_rmost](Vertex tv) {
-            return qv_lmost < tv && tv < qv_rmost;
-          }))
-        break;
-
-      // TODO: Their definition of intersects doesn't actually work here, try
-      // with normal definition? bool intersects = false; for (auto tv : tvs) {
-      //   for (auto qv : *qit) {
-      //     if (intervals_intersect(tv, qv)) {
-      //       std::cerr << "\t(" << tv.lower << ", " << tv.upper << ")
-      //       intersects ("
-      //       << qv.lower << ", " << qv.upper << ")" << std::endl; intersects =
-      //       true; break;
-      //     }
-      //   }
-      //   if (intersects) break;
-      // }
-      // if (intersects) break;
-    }
-    if (qit == pc.end())
+    if (ready.empty())
       return {};
-    auto qvs = std::set<Vertex>(qit->begin(), qit->end());
-    auto qes = path_to_edge_set(*qit);
-    // get leftMost(Tc) and leftMost(q) for next steps
-    Vertex tv_lmost = *tvs.begin();
-    Vertex qv_lmost = *qvs.begin();
+    size_t q = ready.top();
+    ready.pop();
+    done[q] = true;
+
+    const Vertex &tv_lmost = verts[lmost];
+    size_t q_lmost = positions[q].front(), q_rmost = positions[q].back();
+    const Vertex &qv_lmost = verts[q_lmost];
     // if leftMost(q) < leftMost(Tc):
     if (qv_lmost.upper < tv_lmost.upper) {
       // Choose w \in V(q) adjacent to v_leftMost(Tc)
-      std::optional<Vertex> w;
-      for (auto qv : qvs) {
-        if (qv.intersects(tv_lmost)) {
-          w = qv;
-          break;
-        }
-      }
-      if (!w) {
-        std::cerr << "ERROR:" << std::endl;
-        std::cerr << "None of" << std::endl;
-        for (auto qv : qvs) {
-          std::cerr << "\t(" << qv.lower << ", " << qv.upper << ")"
-                    << std::endl;
-        }
-        std::cerr << "intersect (" << tv_lmost.lower << ", " << tv_lmost.upper
-                  << ")" << std::endl;
+      size_t w = first_intersecting(arrays[q], tv_lmost);
+      if (w == arrays[q].size())
         return {};
-      }
       // Update Tc by adding edge between these to connect q to Tc tree
-      tvs.insert(qvs.begin(), qvs.end());
-      tes.insert(qes.begin(), qes.end());
-      tes.insert(Edge(w.value(), tv_lmost));
-    }
-    // if leftMost(q) > leftMost(Tc):
-    if (qv_lmost.upper > tv_lmost.upper) {
+      edges.emplace_back(arrays[q][w], tv_lmost);
+    } else if (qv_lmost.upper > tv_lmost.upper) {
       // Choose w \in V(Tc) adjacent to v_leftMost(q)
-      std::optional<Vertex> w;
-      for (auto tv : tvs) {
-        if (tv.intersects(qv_lmost)) {
-          w = tv;
-          break;
-        }
-      }
-      if (!w)
+      size_t w = tree.first_at_most(
+          interval::first_upper_at_least(verts, qv_lmost.lower),
+          qv_lmost.upper);
+      if (w == n)
         return {};
       // Update Tc by adding edge between these to connect q to Tc tree
-      tvs.insert(qvs.begin(), qvs.end());
-      tes.insert(qes.begin(), qes.end());
-      tes.insert(Edge(w.value(), qv_lmost));
+      edges.emplace_back(verts[w], qv_lmost);
+    } else {
+      // Pc <- Pc \ {q}, leaving Tc as it is
+      continue;
     }
-    // Pc <- Pc \ {q}
-    pc.erase(qit);
+    add_path(q);
+    size_t new_lmost = std::min(lmost, q_lmost);
+    size_t new_rmost = std::max(rmost, q_rmost);
+    sweep(new_lmost + 1, lmost + 1);
+    sweep(rmost, new_rmost);
+    lmost = new_lmost;
+    rmost = new_rmost;
   }
+
   // return Tc
-  return Graph(std::set<Vertex>(tvs.begin(), tvs.end()), tes);
+  std::vector<Vertex> tvs;
+  for (size_t k = 0; k < n; ++k) {
+    if (tree.contains(k))
+      tvs.push_back(verts[k]);
+  }
+  SpanningTree result(std::move(tvs));
+  std::sort(edges.begin(), edges.end());
+  for (const Edge &e : edges) {
+    result.add_edge(e.src, e.dst);
+  }
+  return result;
+}
+
+std::optional<SpanningTree> interval_mist_path_cover(Graph g) {
+  // Find a path cover P* of G
+  return mist_from_path_cover(interval_path_cover(g));
+}
+
+std::optional<SpanningTree>
+interval_mist_path_cover(const IntervalGraph &g) {
+  return mist_from_path_cover(interval_path_cover(g));
+}
+
+std::optional<SpanningTree>
+interval_mist_path_cover(const CompactGraph &g) {
+  return mist_from_path_cover(interval_path_cover(g));
 }
 
-} // namespace interval_mist::solvers::path_cover
\ No newline at end of file
+} // namespace interval_mist::solvers::path_cover
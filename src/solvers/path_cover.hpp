@@ -1,17 +1,36 @@
 #pragma once
 
+#include "../compact_graph.hpp"
 #include "../graph.hpp"
+#include "../interval_graph.hpp"
+#include "../spanning_tree.hpp"
 
 #include <optional>
 #include <vector>
 
 namespace interval_mist::solvers::path_cover {
 
+using CompactGraph = interval_mist::graph::CompactGraph;
 using Graph = interval_mist::graph::Graph;
+using IntervalGraph = interval_mist::graph::IntervalGraph;
+using SpanningTree = interval_mist::graph::SpanningTree;
 using Vertex = Graph::Vertex;
 
+// Follows the edges of g, which need not be those of the interval graph of its
+// vertices
 std::vector<std::vector<Vertex>> interval_path_cover(Graph g);
 
-std::optional<Graph> interval_mist_path_cover(Graph g);
+std::vector<std::vector<Vertex>> interval_path_cover(const IntervalGraph &g);
+
+std::vector<std::vector<Vertex>> interval_path_cover(const CompactGraph &g);
+
+// Joins the path cover of g found by following its edges
+std::optional<SpanningTree> interval_mist_path_cover(Graph g);
+
+std::optional<SpanningTree>
+interval_mist_path_cover(const IntervalGraph &g);
+
+std::optional<SpanningTree>
+interval_mist_path_cover(const CompactGraph &g);
 
 } // namespace interval_mist::solvers::path_cover
\ No newline at end of file
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+
+#include "../generators/intervals.hpp"
+#include "dp.hpp"
+#include "path_cover.hpp"
+
+#include <algorithm>
+#include <set>
+#include <vector>
+
+namespace interval_mist::solvers::path_cover {
+
+namespace intervals = generators::intervals;
+
+using Edge = Graph::Edge;
+
+static std::set<Edge> path_edges(const std::vector<Vertex> &p) {
+  std::set<Edge> result;
+  for (size_t i = 1; i < p.size(); ++i) {
+    result.insert(Edge(p[i - 1], p[i]));
+  }
+  return result;
+}
+
+// The join as first written, rescanning every remaining path against the
+// whole tree at each step, in O(n^2) or worse
+static std::optional<Graph>
+reference_join(std::vector<std::vector<Vertex>> pc) {
+  if (pc.empty())
+    return Graph({}, {});
+
+  std::set<Vertex> tvs(pc.back().begin(), pc.back().end());
+  std::set<Edge> tes = path_edges(pc.back());
+  pc.pop_back();
+  auto between = [](const auto &vs, Vertex lo, Vertex hi) {
+    return std::any_of(vs.begin(), vs.end(),
+                       [&](Vertex v) { return lo < v && v < hi; });
+  };
+
+  while (!pc.empty()) {
+    auto q = std::find_if(pc.begin(), pc.end(), [&](const auto &p) {
+      auto [lo, hi] = std::minmax_element(p.begin(), p.end());
+      return between(p, *tvs.begin(), *tvs.rbegin()) ||
+             between(tvs, *lo, *hi);
+    });
+    if (q == pc.end())
+      return {};
+
+    std::set<Vertex> qvs(q->begin(), q->end());
+    Vertex tv_lmost = *tvs.begin(), qv_lmost = *qvs.begin();
+    if (qv_lmost.upper != tv_lmost.upper) {
+      // Join the leftmost of either to the first of the other meeting it
+      bool q_first = qv_lmost.upper < tv_lmost.upper;
+      Vertex lmost = q_first ? tv_lmost : qv_lmost;
+      const std::set<Vertex> &other = q_first ? qvs : tvs;
+      auto w = std::find_if(other.begin(), other.end(),
+                            [&](Vertex v) { return v.intersects(lmost); });
+      if (w == other.end())
+        return {};
+      tes.insert(Edge(*w, lmost));
+      auto qes = path_edges(*q);
+      tvs.insert(qvs.begin(), qvs.end());
+      tes.insert(qes.begin(), qes.end());
+    }
+    pc.erase(q);
+  }
+  return Graph(tvs, tes);
+}
+
+static Graph graph_of(const std::vector<Vertex> &is) {
+  return Graph::interval_graph_from_set(std::set(is.begin(), is.end()));
+}
+
+TEST(PathCoverTest, FollowsGraphEdges) {
+  // All three intervals meet, but only a and b are joined
+  Vertex a = Vertex(0, 10), b = Vertex(1, 11), c = Vertex(2, 12);
+  Graph g({a, b, c}, {Edge(a, b)});
+  auto pc = interval_path_cover(g);
+  EXPECT_EQ(2, pc.size());
+  EXPECT_EQ(interval_path_cover(CompactGraph(g)), pc);
+}
+
+TEST(PathCoverTest, Empty) {
+  Graph g({}, {});
+  EXPECT_TRUE(interval_path_cover(g).empty());
+  auto tree = interval_mist_path_cover(g);
+  ASSERT_TRUE(tree.has_value());
+  EXPECT_EQ(0, tree->num_verts());
+}
+
+TEST(PathCoverTest, CoversAgree) {
+  for (intervals::Family family : intervals::families) {
+    for (size_t num : {1, 2, 5, 20, 100, 400}) {
+      for (size_t seed = 0; seed < 3; ++seed) {
+        Graph g = graph_of(intervals::generate(family, seed, num));
+        SCOPED_TRACE(intervals::name(family) + " " + std::to_string(num) +
+                     " " + std::to_string(seed));
+        auto pc = interval_path_cover(g);
+        // The edge-free cover finds the same paths as the adjacency greedy
+        EXPECT_EQ(interval_path_cover(CompactGraph(g)), pc);
+        EXPECT_EQ(interval_path_cover(IntervalGraph(g.verts)), pc);
+
+        std::set<Vertex> covered;
+        for (const auto &p : pc) {
+          covered.insert(p.begin(), p.end());
+          for (size_t i = 1; i < p.size(); ++i) {
+            EXPECT_TRUE(p[i - 1].intersects(p[i]));
+          }
+        }
+        EXPECT_EQ(g.verts, covered);
+      }
+    }
+  }
+}
+
+TEST(PathCoverTest, JoinMatchesReference) {
+  for (intervals::Family family : intervals::families) {
+    for (size_t num : {1, 2, 5, 20, 100, 400}) {
+      for (size_t seed = 0; seed < 3; ++seed) {
+        Graph g = graph_of(intervals::generate(family, seed, num));
+        SCOPED_TRACE(intervals::name(family) + " " + std::to_string(num) +
+                     " " + std::to_string(seed));
+        auto expected = reference_join(interval_path_cover(g));
+        auto actual = interval_mist_path_cover(g);
+        ASSERT_EQ(expected.has_value(), actual.has_value());
+        if (actual) {
+          EXPECT_EQ(expected.value(), actual->to_graph());
+          EXPECT_TRUE(actual->is_spanning_tree_of(g.verts));
+        }
+      }
+    }
+  }
+}
+
+TEST(PathCoverTest, NoFewerLeavesThanDp) {
+  // The join can get stuck before every path is in the tree, in which case
+  // the reference gets stuck too
+  size_t joined = 0;
+  for (size_t seed = 0; seed < 200; ++seed) {
+    Graph g = Graph::random_connected_interval_graph(seed, 2 + seed % 11);
+    auto optimal = dp::interval_mist_dp(g);
+    auto expected = reference_join(interval_path_cover(g));
+    auto tree = interval_mist_path_cover(g);
+    ASSERT_TRUE(optimal.has_value());
+    ASSERT_EQ(expected.has_value(), tree.has_value());
+    if (!tree)
+      continue;
+    ++joined;
+    EXPECT_EQ(expected.value(), tree->to_graph());
+    EXPECT_TRUE(tree->is_spanning_tree_of(g.verts));
+    EXPECT_LE(optimal->num_leaves(), tree->num_leaves());
+  }
+  EXPECT_GT(joined, 100);
+}
+
+} // namespace interval_mist::solvers::path_cover
@@ -0,0 +1,179 @@
+#include "registry.hpp"
+
+#include "dp.hpp"
+#include "frontier_dp.hpp"
+#include "greedy.hpp"
+#include "greedy_stream.hpp"
+#include "naive.hpp"
+#include "path_cover.hpp"
+
+#include "../thread_pool.hpp"
+
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+namespace interval_mist::solvers::registry {
+
+static thread_pool::ThreadPool &shared_pool() {
+  static thread_pool::ThreadPool pool;
+  return pool;
+}
+
+static std::optional<SpanningTree> dp_parallel(const CompactGraph &g) {
+  dp::Stats stats;
+  return dp::interval_mist_dp_parallel(g, shared_pool(), stats);
+}
+
+static std::optional<SpanningTree> naive_parallel(const CompactGraph &g) {
+  return naive::interval_mist_naive(g, shared_pool());
+}
+
+using Result = std::optional<SpanningTree>;
+using SolveIntervals = Result (*)(std::span<const Interval>);
+using SolveIntervalGraph = Result (*)(const IntervalGraph &);
+using SolveCompactGraph = Result (*)(const CompactGraph &);
+using SolveGraph = Result (*)(Graph);
+
+const std::vector<Entry> &entries() {
+  static const std::vector<Entry> all = {
+      {
+          .name = "greedy",
+          .description = "Greedy path extension, on the implicit graph",
+          .solve = SolveIntervalGraph(greedy::interval_mist_greedy),
+      },
+      {
+          .name = "greedy_sorted",
+          .description = "Greedy in O(n log n) directly on the intervals",
+          .solve = SolveIntervals(greedy::interval_mist_greedy_sorted),
+          .solve_arrays = greedy::interval_mist_greedy_sorted,
+      },
+      {
+          .name = "greedy_stream",
+          .description = "Greedy consuming intervals in one sweep",
+          .solve = SolveIntervals(greedy::interval_mist_greedy_stream),
+      },
+      {
+          .name = "dp",
+          .description = "Exact DP over vertex degrees",
+          .solve = SolveCompactGraph(dp::interval_mist_dp),
+          .max_verts = dp::max_verts,
+      },
+      {
+          .name = "dp_parallel",
+          .description = "Exact DP a layer at a time, a thread per core",
+          .solve = SolveCompactGraph(dp_parallel),
+          .max_verts = dp::max_verts,
+      },
+      {
+          .name = "frontier_dp",
+          .description = "Exact sweep DP, exponential in the largest clique",
+          .solve = SolveGraph(frontier_dp::interval_mist_frontier_dp),
+          .max_clique = frontier_dp::max_clique,
+      },
+      {
+          .name = "naive",
+          .description = "Exact search over edge subsets",
+          .solve = SolveCompactGraph(naive::interval_mist_naive),
+      },
+      {
+          .name = "naive_parallel",
+          .description = "Exact search over edge subsets, a thread per core",
+          .solve = SolveCompactGraph(naive_parallel),
+      },
+      {
+          .name = "path_cover",
+          .description = "Hamiltonian path if there is one (not exact)",
+          .solve = SolveIntervalGraph(path_cover::interval_mist_path_cover),
+      },
+  };
+  return all;
+}
+
+const Entry *find(std::string_view name) {
+  for (const Entry &entry : entries()) {
+    if (entry.name == name)
+      return &entry;
+  }
+  return nullptr;
+}
+
+// Most intervals sharing a point, by sweeping over endpoints
+template <typename Intervals> static size_t max_clique(const Intervals &is) {
+  std::vector<Interval::Coord> lowers;
+  for (size_t i = 0; i < is.size(); ++i) {
+    lowers.push_back(is[i].lower);
+  }
+  std::sort(lowers.begin(), lowers.end());
+
+  // Intervals are in order of right endpoint, and closed, so interval i is
+  // open at its right endpoint together with every later one starting by then
+  size_t best = 0;
+  for (size_t i = 0; i < is.size(); ++i) {
+    size_t started = std::upper_bound(lowers.begin(), lowers.end(),
+                                      is[i].upper) -
+                     lowers.begin();
+    best = std::max(best, started - i);
+  }
+  return best;
+}
+
+bool fits(const Entry &entry, std::span<const Interval> is) {
+  return is.size() <= entry.max_verts &&
+         (entry.max_clique == unlimited || max_clique(is) <= entry.max_clique);
+}
+
+bool fits(const Entry &entry, const IntervalArrays &is) {
+  return is.size() <= entry.max_verts &&
+         (entry.max_clique == unlimited || max_clique(is) <= entry.max_clique);
+}
+
+std::optional<SpanningTree> run(const Entry &entry,
+                                std::span<const Interval> is,
+                                Scratch &scratch) {
+  auto interval_graph = [&]() -> const IntervalGraph & {
+    if (!scratch.interval_graph)
+      scratch.interval_graph.emplace(std::vector<Interval>());
+    scratch.interval_graph->assign(is);
+    return scratch.interval_graph.value();
+  };
+  return std::visit(
+      [&](auto solve) {
+        using Solve = decltype(solve);
+        if constexpr (std::is_invocable_v<Solve, const IntervalGraph &>) {
+          return solve(interval_graph());
+        } else if constexpr (std::is_invocable_v<Solve, const CompactGraph &>) {
+          const IntervalGraph &g = interval_graph();
+          if (scratch.compact_graph) {
+            scratch.compact_graph->assign(g);
+          } else {
+            scratch.compact_graph.emplace(g);
+          }
+          return solve(scratch.compact_graph.value());
+        } else if constexpr (std::is_invocable_v<Solve, Graph>) {
+          return solve(Graph::interval_graph_from_set({is.begin(), is.end()}));
+        } else {
+          return solve(is);
+        }
+      },
+      entry.solve);
+}
+
+std::optional<SpanningTree> run(const Entry &entry,
+                                std::span<const Interval> is) {
+  Scratch scratch;
+  return run(entry, is, scratch);
+}
+
+std::optional<SpanningTree> run(const Entry &entry, const IntervalArrays &is) {
+  if (entry.solve_arrays)
+    return entry.solve_arrays(is);
+  std::vector<Interval> copy;
+  copy.reserve(is.size());
+  for (size_t i = 0; i < is.size(); ++i) {
+    copy.push_back(is[i]);
+  }
+  return run(entry, copy);
+}
+
+} // namespace interval_mist::solvers::registry
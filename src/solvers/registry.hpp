@@ -0,0 +1,81 @@
+#pragma once
+
+#include "../compact_graph.hpp"
+#include "../graph.hpp"
+#include "../interval.hpp"
+#include "../interval_graph.hpp"
+#include "../spanning_tree.hpp"
+
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+namespace interval_mist::solvers::registry {
+
+using CompactGraph = interval_mist::graph::CompactGraph;
+using Graph = interval_mist::graph::Graph;
+using Interval = interval_mist::interval::Interval;
+using IntervalArrays = interval_mist::interval::IntervalArrays;
+using IntervalGraph = interval_mist::graph::IntervalGraph;
+using SpanningTree = interval_mist::graph::SpanningTree;
+
+// A solver in whichever representation it takes its input, which callers
+// build before running it. Intervals are distinct and in canonical order.
+using Solve =
+    std::variant<std::optional<SpanningTree> (*)(std::span<const Interval>),
+                 std::optional<SpanningTree> (*)(const IntervalGraph &),
+                 std::optional<SpanningTree> (*)(const CompactGraph &),
+                 std::optional<SpanningTree> (*)(Graph)>;
+
+static constexpr size_t unlimited = std::numeric_limits<size_t>::max();
+
+struct Entry {
+  std::string_view name, description;
+  Solve solve;
+  // The same solver reading endpoints in place from separate arrays, such as
+  // a file mapped by io::binary, if it has such a form
+  std::optional<SpanningTree> (*solve_arrays)(const IntervalArrays &) =
+      nullptr;
+  // Largest inputs the solver can take at all, rather than in good time
+  size_t max_verts = unlimited;
+  size_t max_clique = unlimited;
+};
+
+// Every solver, in a fixed order
+const std::vector<Entry> &entries();
+
+// Solver by name, if there is one
+const Entry *find(std::string_view name);
+
+// Whether is is within the limits of entry, counting the largest clique by a
+// sweep only if entry has a limit on it
+bool fits(const Entry &entry, std::span<const Interval> is);
+
+bool fits(const Entry &entry, const IntervalArrays &is);
+
+// Graphs run builds for solvers, kept by callers running many instances so
+// that each is rebuilt in the storage of the one before
+struct Scratch {
+  std::optional<IntervalGraph> interval_graph;
+  std::optional<CompactGraph> compact_graph;
+};
+
+// Builds the representation entry takes from is, which must be distinct and
+// in canonical order, and runs it. An IntervalGraph or CompactGraph is built
+// in scratch; a Graph is built afresh, as its edges are a std::set.
+std::optional<SpanningTree> run(const Entry &entry,
+                                std::span<const Interval> is,
+                                Scratch &scratch);
+
+std::optional<SpanningTree> run(const Entry &entry,
+                                std::span<const Interval> is);
+
+// As above, for intervals held as separate arrays. Solvers with a form that
+// reads the arrays in place run on them as they are, and the others on a copy.
+std::optional<SpanningTree> run(const Entry &entry, const IntervalArrays &is);
+
+} // namespace interval_mist::solvers::registry
@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+
+#include "registry.hpp"
+
+#include <vector>
+
+namespace interval_mist::solvers::registry {
+
+TEST(RegistryTest, ArraysMatchSpan) {
+  auto is = interval::random_connected_intervals(5, 8);
+  std::vector<Interval::Coord> lower, upper;
+  for (Interval i : is) {
+    lower.push_back(i.lower);
+    upper.push_back(i.upper);
+  }
+  IntervalArrays arrays{lower, upper};
+
+  // Solvers with an arrays form, and those run on a copy, agree with the span
+  for (const Entry &entry : entries()) {
+    SCOPED_TRACE(entry.name);
+    EXPECT_EQ(fits(entry, is), fits(entry, arrays));
+    auto expected = run(entry, is);
+    auto actual = run(entry, arrays);
+    ASSERT_EQ(expected.has_value(), actual.has_value());
+    if (expected) {
+      EXPECT_EQ(expected->to_graph(), actual->to_graph());
+    }
+  }
+  EXPECT_TRUE(find("greedy_sorted")->solve_arrays);
+}
+
+TEST(RegistryTest, ScratchReused) {
+  // Larger and smaller instances in turn, so graphs grow and shrink in place
+  for (const Entry &entry : entries()) {
+    SCOPED_TRACE(entry.name);
+    Scratch scratch;
+    for (size_t num : {9, 2, 1, 7, 10, 3}) {
+      auto is = interval::random_connected_intervals(num, num);
+      auto expected = run(entry, is);
+      auto actual = run(entry, is, scratch);
+      ASSERT_EQ(expected.has_value(), actual.has_value()) << num;
+      if (expected) {
+        EXPECT_EQ(expected->to_graph(), actual->to_graph()) << num;
+      }
+    }
+  }
+}
+
+} // namespace interval_mist::solvers::registry
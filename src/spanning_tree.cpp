@@ -0,0 +1,158 @@
+#include "spanning_tree.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+
+namespace interval_mist::graph {
+
+using Vertex = SpanningTree::Vertex;
+using Edge = SpanningTree::Edge;
+using Id = SpanningTree::Id;
+
+SpanningTree::SpanningTree(std::vector<Vertex> vs)
+    : verts(std::move(vs)), parent_of(verts.size(), no_parent),
+      degrees(verts.size(), 0), uf(verts.size()), uf_size(verts.size(), 1) {
+  assert(verts.size() < no_parent);
+  std::iota(uf.begin(), uf.end(), 0);
+  assert(std::adjacent_find(verts.begin(), verts.end(),
+                            std::greater_equal<Vertex>()) == verts.end());
+}
+
+SpanningTree::SpanningTree(const Graph &g)
+    : SpanningTree(std::vector<Vertex>(g.verts.begin(), g.verts.end())) {
+  for (Edge e : g.edges) {
+    add_edge(e.src, e.dst);
+  }
+}
+
+size_t SpanningTree::num_verts() const { return verts.size(); }
+
+size_t SpanningTree::num_edges() const { return edge_count; }
+
+const std::vector<Vertex> &SpanningTree::vertices() const { return verts; }
+
+const Vertex &SpanningTree::vertex(Id u) const { return verts[u]; }
+
+std::optional<Id> SpanningTree::id_of(const Vertex &v) const {
+  auto it = std::lower_bound(verts.begin(), verts.end(), v);
+  if (it == verts.end() || *it != v)
+    return {};
+  return it - verts.begin();
+}
+
+void SpanningTree::add_edge(Id u, Id v) {
+  assert(u != v);
+  for (Id w : {u, v}) {
+    if (degrees[w] == 0) {
+      ++leaf_count;
+    } else if (degrees[w] == 1) {
+      --leaf_count;
+      ++internal_count;
+    }
+    ++degrees[w];
+  }
+  ++edge_count;
+
+  Id ru = find(u), rv = find(v);
+  if (ru == rv) {
+    cyclic = true;
+    return;
+  }
+  if (parent_of[v] == no_parent) {
+    parent_of[v] = u;
+  } else if (parent_of[u] == no_parent) {
+    parent_of[u] = v;
+  } else if (uf_size[ru] <= uf_size[rv]) {
+    make_root(u);
+    parent_of[u] = v;
+  } else {
+    make_root(v);
+    parent_of[v] = u;
+  }
+
+  if (uf_size[ru] < uf_size[rv])
+    std::swap(ru, rv);
+  uf[rv] = ru;
+  uf_size[ru] += uf_size[rv];
+}
+
+Id SpanningTree::find(Id u) {
+  while (uf[u] != u) {
+    u = uf[u] = uf[uf[u]];
+  }
+  return u;
+}
+
+void SpanningTree::add_edge(Vertex u, Vertex v) {
+  auto uid = id_of(u), vid = id_of(v);
+  assert(uid && vid);
+  add_edge(uid.value(), vid.value());
+}
+
+void SpanningTree::make_root(Id u) {
+  // Reverse the path from u to its root. No edge closing a cycle is linked, so
+  // parent links always form a forest.
+  Id prev = no_parent;
+  while (u != no_parent) {
+    Id next = parent_of[u];
+    parent_of[u] = prev;
+    prev = u;
+    u = next;
+  }
+}
+
+Id SpanningTree::parent(Id u) const { return parent_of[u]; }
+
+std::span<const Id> SpanningTree::parents() const { return parent_of; }
+
+size_t SpanningTree::degree(Id u) const { return degrees[u]; }
+
+size_t SpanningTree::num_leaves() const { return leaf_count; }
+
+size_t SpanningTree::num_internal() const { return internal_count; }
+
+bool SpanningTree::is_valid() const {
+  // As for Graph::is_tree, the empty graph is not a tree. Linked edges never
+  // close a cycle, so n - 1 of them with none refused form a spanning tree.
+  return !cyclic && !verts.empty() && edge_count == verts.size() - 1;
+}
+
+bool SpanningTree::is_spanning_tree_of(std::span<const Vertex> vs) const {
+  if (!std::equal(vs.begin(), vs.end(), verts.begin(), verts.end()) ||
+      !is_valid())
+    return false;
+  for (Id u = 0; u < verts.size(); ++u) {
+    if (parent_of[u] != no_parent &&
+        !verts[u].intersects(verts[parent_of[u]]))
+      return false;
+  }
+  return true;
+}
+
+bool SpanningTree::is_spanning_tree_of(const std::set<Vertex> &vs) const {
+  return vs.size() == verts.size() &&
+         std::equal(vs.begin(), vs.end(), verts.begin()) &&
+         is_spanning_tree_of(std::span<const Vertex>(verts));
+}
+
+bool SpanningTree::is_spanning_tree_of(const IntervalArrays &vs) const {
+  if (vs.size() != verts.size())
+    return false;
+  for (Id u = 0; u < verts.size(); ++u) {
+    if (vs[u] != verts[u])
+      return false;
+  }
+  return is_spanning_tree_of(std::span<const Vertex>(verts));
+}
+
+Graph SpanningTree::to_graph() const {
+  std::set<Edge> es;
+  for (Id u = 0; u < verts.size(); ++u) {
+    if (parent_of[u] != no_parent)
+      es.insert(Edge(verts[u], verts[parent_of[u]]));
+  }
+  return Graph(std::set<Vertex>(verts.begin(), verts.end()), es);
+}
+
+} // namespace interval_mist::graph
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "graph.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <set>
+#include <span>
+#include <vector>
+
+namespace interval_mist::graph {
+
+// Tree (or forest, while being built) over dense ids in canonical order, stored
+// as a parent array with the degree of every vertex. Leaf and internal counts
+// are kept up to date as edges are added, as is a union-find of the trees, so
+// reading them and validating the whole tree are O(1).
+struct SpanningTree {
+  using Vertex = Graph::Vertex;
+  using Edge = Graph::Edge;
+  using Id = uint32_t;
+  using IntervalArrays = interval_mist::interval::IntervalArrays;
+
+  static constexpr Id no_parent = std::numeric_limits<Id>::max();
+
+  // No edges over vertices, which must be distinct and in canonical order
+  SpanningTree(std::vector<Vertex> verts);
+
+  // Edges of g over its vertices, with no check that g is a tree
+  SpanningTree(const Graph &g);
+
+  size_t num_verts() const;
+
+  size_t num_edges() const;
+
+  const std::vector<Vertex> &vertices() const;
+
+  const Vertex &vertex(Id) const;
+
+  std::optional<Id> id_of(const Vertex &) const;
+
+  // Adds the edge, making whichever endpoint is a root the child of the
+  // other. If neither is, the endpoint in the smaller tree (u on a tie) first
+  // becomes the root of it, in time linear in its depth, so adding edges in
+  // any order takes O(n log n) in all. An edge between vertices already
+  // connected closes a cycle, and is counted but not linked.
+  void add_edge(Id u, Id v);
+
+  void add_edge(Vertex u, Vertex v);
+
+  // Parent of u, or no_parent for the root of each tree
+  Id parent(Id u) const;
+
+  std::span<const Id> parents() const;
+
+  size_t degree(Id u) const;
+
+  size_t num_leaves() const;
+
+  size_t num_internal() const;
+
+  // Whether the edges form one tree over all the vertices
+  bool is_valid() const;
+
+  // Whether this is a valid tree whose vertices are exactly vs and whose edges
+  // all join intersecting intervals, so it spans their interval graph
+  bool is_spanning_tree_of(std::span<const Vertex> vs) const;
+
+  bool is_spanning_tree_of(const std::set<Vertex> &vs) const;
+
+  bool is_spanning_tree_of(const IntervalArrays &vs) const;
+
+  Graph to_graph() const;
+
+private:
+  std::vector<Vertex> verts;
+  std::vector<Id> parent_of;
+  std::vector<uint32_t> degrees;
+  // Union-find by size over the trees, with path halving
+  std::vector<Id> uf, uf_size;
+  size_t edge_count = 0, leaf_count = 0, internal_count = 0;
+  // Set once an edge closes a cycle
+  bool cyclic = false;
+
+  Id find(Id u);
+
+  void make_root(Id u);
+};
+
+} // namespace interval_mist::graph
@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+
+#include "spanning_tree.hpp"
+
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace interval_mist::graph {
+
+using Vertex = SpanningTree::Vertex;
+using Edge = SpanningTree::Edge;
+using Id = SpanningTree::Id;
+using IntervalArrays = SpanningTree::IntervalArrays;
+
+// Canonical order: a, b, c, d
+static const Vertex a = Vertex(0, 2), b = Vertex(1, 4), c = Vertex(3, 6),
+                    d = Vertex(2, 7);
+
+TEST(SpanningTreeTest, Empty) {
+  SpanningTree t((std::vector<Vertex>()));
+  EXPECT_EQ(0, t.num_verts());
+  EXPECT_EQ(0, t.num_leaves());
+  EXPECT_FALSE(t.is_valid());
+}
+
+TEST(SpanningTreeTest, SingleVertex) {
+  SpanningTree t({a});
+  EXPECT_EQ(0, t.num_leaves());
+  EXPECT_EQ(0, t.num_internal());
+  EXPECT_TRUE(t.is_valid());
+  EXPECT_TRUE(t.is_spanning_tree_of(std::set<Vertex>{a}));
+}
+
+TEST(SpanningTreeTest, Path) {
+  SpanningTree t({a, b, c, d});
+  t.add_edge(0, 1);
+  t.add_edge(1, 2);
+  EXPECT_EQ(2, t.num_leaves());
+  EXPECT_EQ(1, t.num_internal());
+  EXPECT_FALSE(t.is_valid());
+
+  t.add_edge(2, 3);
+  EXPECT_EQ(2, t.num_leaves());
+  EXPECT_EQ(2, t.num_internal());
+  EXPECT_EQ(3, t.num_edges());
+  EXPECT_TRUE(t.is_valid());
+  EXPECT_TRUE(t.is_spanning_tree_of(std::vector<Vertex>{a, b, c, d}));
+  EXPECT_EQ(SpanningTree::no_parent, t.parent(0));
+  EXPECT_EQ(2, t.parent(3));
+}
+
+TEST(SpanningTreeTest, JoinsTreesByRerooting) {
+  // Two paths, a-b and c-d, joined between non-roots b and d
+  SpanningTree t({a, b, c, d});
+  t.add_edge(Vertex(a), Vertex(b));
+  t.add_edge(c, d);
+  t.add_edge(b, d);
+  EXPECT_TRUE(t.is_valid());
+  EXPECT_EQ(2, t.num_leaves());
+  EXPECT_EQ(Graph({a, b, c, d}, {Edge(a, b), Edge(c, d), Edge(b, d)}),
+            t.to_graph());
+}
+
+TEST(SpanningTreeTest, Cycle) {
+  SpanningTree t({a, b, c, d});
+  t.add_edge(0, 1);
+  t.add_edge(1, 2);
+  t.add_edge(2, 0);
+  EXPECT_EQ(3, t.num_edges());
+  EXPECT_FALSE(t.is_valid());
+  EXPECT_EQ(0, t.num_leaves());
+}
+
+TEST(SpanningTreeTest, CycleThenReroot) {
+  // The cycle 2-4-3-7 is closed by 3-7, and 4-6 then joins a vertex on it to
+  // another tree, which must not hide the cycle
+  std::vector<Vertex> vs;
+  for (Vertex::Coord i = 0; i < 8; ++i) {
+    vs.push_back(Vertex(i, 20));
+  }
+  SpanningTree t(vs);
+  for (auto [u, v] : std::vector<std::pair<Id, Id>>{
+           {0, 1}, {1, 6}, {2, 4}, {2, 7}, {3, 4}, {3, 7}, {4, 6}}) {
+    t.add_edge(u, v);
+  }
+  EXPECT_EQ(7, t.num_edges());
+  EXPECT_FALSE(t.is_valid());
+}
+
+TEST(SpanningTreeTest, RerootsSmallerSide) {
+  // A long path rooted at 0, joined by its far end to a pair rooted at 1. The
+  // pair is rerooted rather than the path.
+  size_t n = 1000;
+  std::vector<Vertex> vs;
+  for (Vertex::Coord i = 0; i < n; ++i) {
+    vs.push_back(Vertex(i, i + 2));
+  }
+  SpanningTree t(vs);
+  for (Id u = 2; u + 1 < n; ++u) {
+    t.add_edge(u, u + 1);
+  }
+  t.add_edge(0, 1);
+  t.add_edge(n - 1, 1);
+  EXPECT_EQ(SpanningTree::no_parent, t.parent(2));
+  EXPECT_EQ(n - 2, t.parent(n - 1));
+  EXPECT_EQ(n - 1, t.parent(1));
+  EXPECT_EQ(1, t.parent(0));
+  EXPECT_TRUE(t.is_valid());
+
+  t.add_edge(0, 2);
+  EXPECT_FALSE(t.is_valid());
+}
+
+TEST(SpanningTreeTest, NotSpanningTreeOf) {
+  // a and c do not intersect
+  SpanningTree t({a, b, c});
+  t.add_edge(0, 2);
+  t.add_edge(1, 2);
+  EXPECT_TRUE(t.is_valid());
+  EXPECT_FALSE(t.is_spanning_tree_of(std::vector<Vertex>{a, b, c}));
+
+  SpanningTree u({a, b, c});
+  u.add_edge(0, 1);
+  u.add_edge(1, 2);
+  EXPECT_TRUE(u.is_spanning_tree_of(std::vector<Vertex>{a, b, c}));
+  EXPECT_FALSE(u.is_spanning_tree_of(std::vector<Vertex>{a, b, c, d}));
+}
+
+TEST(SpanningTreeTest, SpanningTreeOfArrays) {
+  SpanningTree t({a, b, c, d});
+  t.add_edge(0, 1);
+  t.add_edge(1, 2);
+  t.add_edge(2, 3);
+
+  std::vector<Vertex::Coord> lower = {0, 1, 3, 2}, upper = {2, 4, 6, 7};
+  EXPECT_TRUE(t.is_spanning_tree_of(IntervalArrays{lower, upper}));
+  EXPECT_FALSE(t.is_spanning_tree_of(IntervalArrays{
+      std::span(lower).first(3), std::span(upper).first(3)}));
+  upper[3] = 8;
+  EXPECT_FALSE(t.is_spanning_tree_of(IntervalArrays{lower, upper}));
+}
+
+TEST(SpanningTreeTest, FromGraph) {
+  Graph g({a, b, c, d}, {Edge(a, b), Edge(b, c), Edge(b, d)});
+  SpanningTree t(g);
+  EXPECT_EQ(g.num_leaves(), t.num_leaves());
+  EXPECT_EQ(3, t.degree(*t.id_of(b)));
+  EXPECT_TRUE(t.is_spanning_tree_of(g.verts));
+  EXPECT_EQ(g, t.to_graph());
+  EXPECT_FALSE(t.id_of(Vertex(8, 9)).has_value());
+}
+
+} // namespace interval_mist::graph
@@ -1,7 +1,15 @@
 #include "tester.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <iostream>
-#include <random>
+#include <map>
+#include <mutex>
+#include <set>
+#include <tuple>
+#include <vector>
 
 namespace interval_mist::tester {
 
@@ -21,7 +29,7 @@ void Result::report(std::ostream &os, std::string lhs_name,
   if (lhs) {
     os << "found MIST with " << lhs.value().num_leaves() << " leaves"
        << std::endl;
-    lhs.value().report_edges(os);
+    lhs.value().to_graph().report_edges(os);
   } else {
     os << "no MIST found";
   }
@@ -30,7 +38,7 @@ void Result::report(std::ostream &os, std::string lhs_name,
   if (rhs) {
     os << "found MIST with " << rhs.value().num_leaves() << " leaves"
        << std::endl;
-    rhs.value().report_edges(os);
+    rhs.value().to_graph().report_edges(os);
   } else {
     os << "no MIST found";
   }
@@ -58,29 +66,184 @@ Result compare_solvers(Solver lhs, Solver rhs, size_t seed, size_t num_verts) {
   return compare_solvers(lhs, rhs, g);
 }
 
+size_t test_seed(size_t seed, size_t test) {
+  // Output number test of a SplitMix64 generator seeded with seed
+  uint64_t z = seed + (test + 1) * 0x9E3779B97F4A7C15ull;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+std::optional<Result> fuzz_compare_solvers(Solver lhs, Solver rhs,
+                                           size_t num_tests, size_t seed,
+                                           size_t num_verts,
+                                           thread_pool::ThreadPool &pool) {
+  std::cerr << "Running " << num_tests << " tests on " << pool.num_threads()
+            << " threads..." << std::endl;
+  auto start = std::chrono::steady_clock::now();
+
+  std::atomic<size_t> first_failure = num_tests, num_run = 0;
+  std::optional<Result> failure;
+  std::mutex mutex;
+
+  pool.parallel_for(num_tests, [&](size_t test) {
+    if (test > first_failure.load())
+      return;
+
+    Result result =
+        compare_solvers(lhs, rhs, test_seed(seed, test), num_verts);
+    ++num_run;
+    if (result.agree())
+      return;
+
+    std::lock_guard lock(mutex);
+    if (test < first_failure.load()) {
+      first_failure = test;
+      failure = std::move(result);
+    }
+  });
+
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  if (failure) {
+    std::cerr << "Solvers disagree for test = " << first_failure.load()
+              << ", seed = " << test_seed(seed, first_failure.load())
+              << ", num_verts = " << num_verts << std::endl;
+  }
+  std::cerr << "Ran " << num_run.load() << " tests in " << elapsed.count()
+            << "s (" << num_run.load() / elapsed.count() << " tests/s)"
+            << std::endl;
+
+  return failure;
+}
+
 std::optional<Result> fuzz_compare_solvers(Solver lhs, Solver rhs,
                                            size_t num_tests, size_t seed,
                                            size_t num_verts) {
-  std::default_random_engine rng(seed);
-
-  for (size_t test = 0; test < num_tests; ++test) {
-    std::cerr << "Running test " << (test + 1) << " / " << num_tests << "...";
-
-    size_t seed = rng();
-    Result result = compare_solvers(lhs, rhs, seed, num_verts);
-    if (!result.agree()) {
-      std::cerr << std::endl;
-      std::cerr << "Solvers disagree for seed = " << seed
-                << ", num_verts = " << num_verts << std::endl;
-      return result;
+  thread_pool::ThreadPool pool;
+  return fuzz_compare_solvers(lhs, rhs, num_tests, seed, num_verts, pool);
+}
+
+using Vertex = Graph::Vertex;
+
+// Renumbers endpoints to 0, 1, 2, ... in sweep order. Lower endpoints go
+// before upper ones at a shared coordinate, so touching intervals still meet
+// and the interval graph is unchanged.
+static std::set<Vertex> normalise(const std::set<Vertex> &vs) {
+  std::vector<Vertex> verts(vs.begin(), vs.end());
+  std::vector<std::tuple<Vertex::Coord, bool, size_t>> ends;
+  for (size_t i = 0; i < verts.size(); ++i) {
+    ends.emplace_back(verts[i].lower, false, i);
+    ends.emplace_back(verts[i].upper, true, i);
+  }
+  std::sort(ends.begin(), ends.end());
+
+  std::vector<Vertex::Coord> lower(verts.size()), upper(verts.size());
+  for (size_t rank = 0; rank < ends.size(); ++rank) {
+    auto [coord, is_upper, i] = ends[rank];
+    (is_upper ? upper : lower)[i] = rank;
+  }
+
+  std::set<Vertex> result;
+  for (size_t i = 0; i < verts.size(); ++i) {
+    result.insert(Vertex(lower[i], upper[i]));
+  }
+  return result;
+}
+
+// Decides whether the solvers disagree on inputs, remembering each answer
+struct Shrinker {
+  Solver lhs, rhs;
+  thread_pool::ThreadPool &pool;
+
+  std::mutex mutex;
+  std::map<std::set<Vertex>, bool> seen;
+  size_t num_runs = 0;
+
+  Shrinker(Solver lhs, Solver rhs, thread_pool::ThreadPool &pool)
+      : lhs(lhs), rhs(rhs), pool(pool) {}
+
+  bool disagree(const std::set<Vertex> &vs) {
+    {
+      std::lock_guard lock(mutex);
+      if (auto it = seen.find(vs); it != seen.end())
+        return it->second;
     }
 
-    std::cerr << '\r';
+    // Solvers need not handle disconnected input, so it never counts
+    auto g = Graph::interval_graph_from_set(vs);
+    bool result = g.is_connected() && !compare_solvers(lhs, rhs, g).agree();
+
+    std::lock_guard lock(mutex);
+    seen.emplace(vs, result);
+    ++num_runs;
+    return result;
+  }
+
+  // Lowest index of a candidate the solvers disagree on, if any, so the
+  // choice does not depend on the number of threads
+  std::optional<size_t>
+  first_disagreement(const std::vector<std::set<Vertex>> &candidates) {
+    std::atomic<size_t> first = candidates.size();
+    pool.parallel_for(candidates.size(), [&](size_t i) {
+      if (i > first.load() || !disagree(candidates[i]))
+        return;
+      size_t curr = first.load();
+      while (i < curr && !first.compare_exchange_weak(curr, i)) {
+      }
+    });
+    if (first == candidates.size())
+      return {};
+    return first.load();
   }
+};
 
-  std::cerr << std::endl;
+Result shrink(Solver lhs, Solver rhs, const Result &failure,
+              thread_pool::ThreadPool &pool) {
+  Shrinker shrinker(lhs, rhs, pool);
+  std::vector<Vertex> verts(failure.input.verts.begin(),
+                            failure.input.verts.end());
+
+  // Try removing each of some number of equal groups, moving to finer groups
+  // when none can go
+  size_t num_groups = 2;
+  while (verts.size() >= 2) {
+    num_groups = std::min(num_groups, verts.size());
+    std::vector<std::set<Vertex>> candidates;
+    for (size_t group = 0; group < num_groups; ++group) {
+      size_t begin = verts.size() * group / num_groups;
+      size_t end = verts.size() * (group + 1) / num_groups;
+      std::set<Vertex> candidate(verts.begin(), verts.begin() + begin);
+      candidate.insert(verts.begin() + end, verts.end());
+      candidates.push_back(std::move(candidate));
+    }
+
+    if (auto i = shrinker.first_disagreement(candidates)) {
+      verts.assign(candidates[*i].begin(), candidates[*i].end());
+      num_groups = std::max<size_t>(num_groups - 1, 2);
+    } else if (num_groups == verts.size()) {
+      break;
+    } else {
+      num_groups = std::min(2 * num_groups, verts.size());
+    }
+  }
+
+  // Renumbering can change how solvers break ties, so keep it only if the
+  // disagreement survives
+  std::set<Vertex> result(verts.begin(), verts.end());
+  if (auto normalised = normalise(result); shrinker.disagree(normalised))
+    result = normalised;
+
+  std::cerr << "Shrunk " << failure.input.verts.size() << " intervals to "
+            << result.size() << " with " << shrinker.num_runs
+            << " solver runs" << std::endl;
+
+  return compare_solvers(lhs, rhs, Graph::interval_graph_from_set(result));
+}
 
-  return {};
+Result shrink(Solver lhs, Solver rhs, const Result &failure) {
+  thread_pool::ThreadPool pool;
+  return shrink(lhs, rhs, failure, pool);
 }
 
 } // namespace interval_mist::tester
\ No newline at end of file
@@ -1,18 +1,21 @@
 #pragma once
 
 #include "graph.hpp"
+#include "spanning_tree.hpp"
+#include "thread_pool.hpp"
 
 #include <optional>
 
 namespace interval_mist::tester {
 
 using Graph = interval_mist::graph::Graph;
+using SpanningTree = interval_mist::graph::SpanningTree;
 
-using Solver = std::optional<Graph> (*)(Graph);
+using Solver = std::optional<SpanningTree> (*)(Graph);
 
 struct Result {
   Graph input;
-  std::optional<Graph> lhs, rhs;
+  std::optional<SpanningTree> lhs, rhs;
 
   bool agree() const;
 
@@ -24,8 +27,32 @@ Result compare_solvers(Solver lhs, Solver rhs, Graph graph);
 
 Result compare_solvers(Solver lhs, Solver rhs, size_t seed, size_t num_verts);
 
+// Seed of test number test in a fuzz run from seed, so that any test can be
+// rerun alone with compare_solvers
+size_t test_seed(size_t seed, size_t test);
+
+// Runs tests across pool, returning the lowest numbered disagreement (if
+// any), so the result does not depend on the number of threads. Tests after a
+// known disagreement are skipped.
+std::optional<Result> fuzz_compare_solvers(Solver lhs, Solver rhs,
+                                           size_t num_tests, size_t seed,
+                                           size_t num_verts,
+                                           thread_pool::ThreadPool &pool);
+
+// As above, with a thread per core
 std::optional<Result> fuzz_compare_solvers(Solver lhs, Solver rhs,
                                            size_t num_tests, size_t seed,
                                            size_t num_verts);
 
+// Reduces a disagreement to a smaller connected input on which the solvers
+// still disagree, by removing ever smaller groups of intervals until no single
+// interval can go (as in delta debugging), then renumbering the endpoints to
+// 0, 1, 2, ... Candidate inputs are tried across pool, and each distinct input
+// is solved at most once.
+Result shrink(Solver lhs, Solver rhs, const Result &failure,
+              thread_pool::ThreadPool &pool);
+
+// As above, with a thread per core
+Result shrink(Solver lhs, Solver rhs, const Result &failure);
+
 } // namespace interval_mist::tester
\ No newline at end of file
@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+
+#include "solvers.hpp"
+#include "tester.hpp"
+
+#include <vector>
+
+namespace interval_mist::tester {
+
+using Vertex = Graph::Vertex;
+
+static Result path_cover_failure(size_t num_verts) {
+  thread_pool::ThreadPool pool(1);
+  auto failure = fuzz_compare_solvers(
+      solvers::path_cover::interval_mist_path_cover,
+      solvers::naive::interval_mist_naive, 1000, 5, num_verts, pool);
+  EXPECT_TRUE(failure.has_value());
+  return failure.value();
+}
+
+TEST(TesterTest, FuzzIndependentOfThreads) {
+  Solver lhs = solvers::path_cover::interval_mist_path_cover;
+  Solver rhs = solvers::naive::interval_mist_naive;
+  size_t num_tests = 1000, seed = 5, num_verts = 10;
+
+  thread_pool::ThreadPool serial(1), parallel(4);
+  auto serial_failure =
+      fuzz_compare_solvers(lhs, rhs, num_tests, seed, num_verts, serial);
+  auto parallel_failure =
+      fuzz_compare_solvers(lhs, rhs, num_tests, seed, num_verts, parallel);
+  ASSERT_TRUE(serial_failure.has_value());
+  ASSERT_TRUE(parallel_failure.has_value());
+  EXPECT_EQ(serial_failure->input, parallel_failure->input);
+
+  // The lowest numbered disagreement, rerun alone from its seed
+  size_t test = 0;
+  while (test < num_tests &&
+         compare_solvers(lhs, rhs, test_seed(seed, test), num_verts).agree()) {
+    ++test;
+  }
+  ASSERT_LT(test, num_tests);
+  auto rerun = compare_solvers(lhs, rhs, test_seed(seed, test), num_verts);
+  EXPECT_FALSE(rerun.agree());
+  EXPECT_EQ(serial_failure->input, rerun.input);
+}
+
+TEST(TesterTest, ShrinkIsMinimal) {
+  Solver lhs = solvers::path_cover::interval_mist_path_cover;
+  Solver rhs = solvers::naive::interval_mist_naive;
+  auto failure = path_cover_failure(10);
+
+  thread_pool::ThreadPool pool(3);
+  auto result = shrink(lhs, rhs, failure, pool);
+  EXPECT_FALSE(result.agree());
+  EXPECT_TRUE(result.input.is_connected());
+  EXPECT_LE(result.input.verts.size(), failure.input.verts.size());
+
+  // Endpoints are renumbered to 0, 1, 2, ...
+  std::vector<bool> used(2 * result.input.verts.size(), false);
+  for (Vertex v : result.input.verts) {
+    ASSERT_LT(v.upper, used.size());
+    used[v.lower] = used[v.upper] = true;
+  }
+  EXPECT_EQ(std::vector<bool>(used.size(), true), used);
+
+  // No single interval can be removed
+  for (Vertex v : result.input.verts) {
+    auto vs = result.input.verts;
+    vs.erase(v);
+    auto g = Graph::interval_graph_from_set(vs);
+    if (g.is_connected()) {
+      EXPECT_TRUE(compare_solvers(lhs, rhs, g).agree());
+    }
+  }
+}
+
+TEST(TesterTest, ShrinkIndependentOfThreads) {
+  Solver lhs = solvers::path_cover::interval_mist_path_cover;
+  Solver rhs = solvers::naive::interval_mist_naive;
+  auto failure = path_cover_failure(10);
+
+  thread_pool::ThreadPool serial(1), parallel(4);
+  EXPECT_EQ(shrink(lhs, rhs, failure, serial).input.verts,
+            shrink(lhs, rhs, failure, parallel).input.verts);
+}
+
+} // namespace interval_mist::tester
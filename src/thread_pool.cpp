@@ -0,0 +1,126 @@
+#include "thread_pool.hpp"
+
+#include <algorithm>
+
+namespace interval_mist::thread_pool {
+
+ThreadPool::ThreadPool(size_t num_threads)
+    : ranges(new Range[std::max<size_t>(num_threads, 1)]) {
+  // Slot 0 is for the thread calling parallel_for
+  for (size_t slot = 1; slot < std::max<size_t>(num_threads, 1); ++slot) {
+    workers.emplace_back([this, slot]() { work(slot); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard lock(mutex);
+    stopping = true;
+  }
+  work_cv.notify_all();
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+}
+
+size_t ThreadPool::num_threads() const { return workers.size() + 1; }
+
+void ThreadPool::parallel_for(size_t n, const std::function<void(size_t)> &fn) {
+  parallel_for(n, [&fn](size_t i, size_t) { fn(i); });
+}
+
+void ThreadPool::parallel_for(size_t n,
+                              const std::function<void(size_t, size_t)> &fn) {
+  std::lock_guard loop_lock(loop_mutex);
+
+  // Deal out the indices in equal contiguous shares
+  for (size_t slot = 0; slot < num_threads(); ++slot) {
+    std::lock_guard range_lock(ranges[slot].mutex);
+    ranges[slot].begin = n * slot / num_threads();
+    ranges[slot].end = n * (slot + 1) / num_threads();
+  }
+
+  {
+    std::lock_guard lock(mutex);
+    job = &fn;
+    job_size = n;
+    finished = 0;
+    ++generation;
+  }
+  work_cv.notify_all();
+
+  run(0);
+
+  std::unique_lock lock(mutex);
+  done_cv.wait(lock, [this]() { return finished == job_size && active == 0; });
+  job = nullptr;
+}
+
+void ThreadPool::work(size_t slot) {
+  size_t seen = 0;
+  std::unique_lock lock(mutex);
+  while (true) {
+    work_cv.wait(lock, [&]() { return stopping || generation != seen; });
+    if (stopping)
+      return;
+    seen = generation;
+    // Woken too late, and the caller finished the loop alone
+    if (!job)
+      continue;
+
+    ++active;
+    lock.unlock();
+    run(slot);
+    lock.lock();
+    --active;
+    if (finished == job_size && active == 0)
+      done_cv.notify_all();
+  }
+}
+
+void ThreadPool::run(size_t slot) {
+  const std::function<void(size_t, size_t)> &fn = *job;
+  size_t done = 0;
+  for (size_t i; claim(slot, i);) {
+    fn(i, slot);
+    ++done;
+  }
+
+  std::lock_guard lock(mutex);
+  finished += done;
+}
+
+bool ThreadPool::claim(size_t slot, size_t &i) {
+  {
+    Range &own = ranges[slot];
+    std::lock_guard lock(own.mutex);
+    if (own.begin < own.end) {
+      i = own.begin++;
+      return true;
+    }
+  }
+
+  // Steal the back half of the first other share with anything left
+  for (size_t k = 1; k < num_threads(); ++k) {
+    Range &victim = ranges[(slot + k) % num_threads()];
+    size_t begin, end;
+    {
+      std::lock_guard lock(victim.mutex);
+      if (victim.begin == victim.end)
+        continue;
+      begin = victim.begin + (victim.end - victim.begin) / 2;
+      end = victim.end;
+      victim.end = begin;
+    }
+    // Only this thread adds to its own share, so it is still empty
+    Range &own = ranges[slot];
+    std::lock_guard lock(own.mutex);
+    i = begin;
+    own.begin = begin + 1;
+    own.end = end;
+    return true;
+  }
+  return false;
+}
+
+} // namespace interval_mist::thread_pool
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace interval_mist::thread_pool {
+
+// Fixed set of worker threads for data parallel loops. The calling thread
+// joins in on each loop, so a pool of one thread runs everything inline.
+struct ThreadPool {
+  ThreadPool(size_t num_threads = std::thread::hardware_concurrency());
+
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  // Number of threads running loops, including the caller
+  size_t num_threads() const;
+
+  // Run fn(i) for each i in [0, n) across the pool, returning once all are
+  // done. Each thread starts on its own contiguous share of the indices and,
+  // once that runs out, steals half of what remains of another's. Loops from
+  // different threads take turns; fn must not start a loop on the same pool.
+  void parallel_for(size_t n, const std::function<void(size_t)> &fn);
+
+  // As above, calling fn(i, slot) where slot, in [0, num_threads()), is the
+  // thread running it. No two calls with the same slot overlap, so fn can
+  // keep per-thread scratch space indexed by slot without locking.
+  void parallel_for(size_t n, const std::function<void(size_t, size_t)> &fn);
+
+private:
+  // Indices not yet claimed from one thread's share
+  struct Range {
+    std::mutex mutex;
+    size_t begin = 0, end = 0;
+  };
+
+  std::vector<std::thread> workers;
+  std::unique_ptr<Range[]> ranges;
+
+  std::mutex loop_mutex;
+
+  std::mutex mutex;
+  std::condition_variable work_cv, done_cv;
+  bool stopping = false;
+
+  // Current loop, which changes only when no worker is inside it
+  size_t generation = 0;
+  const std::function<void(size_t, size_t)> *job = nullptr;
+  size_t job_size = 0, finished = 0, active = 0;
+
+  void work(size_t slot);
+
+  // Claim and run indices of the current loop until none remain anywhere
+  void run(size_t slot);
+
+  bool claim(size_t slot, size_t &i);
+};
+
+} // namespace interval_mist::thread_pool
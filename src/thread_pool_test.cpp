@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+
+#include "thread_pool.hpp"
+
+#include <atomic>
+
+namespace interval_mist::thread_pool {
+
+TEST(ThreadPoolTest, Inline) {
+  ThreadPool pool(1);
+  EXPECT_EQ(1, pool.num_threads());
+  std::vector<size_t> order;
+  pool.parallel_for(5, [&order](size_t i) { order.push_back(i); });
+  EXPECT_EQ(std::vector<size_t>({0, 1, 2, 3, 4}), order);
+}
+
+TEST(ThreadPoolTest, Empty) {
+  ThreadPool pool(4);
+  pool.parallel_for(0, [](size_t) { FAIL(); });
+}
+
+TEST(ThreadPoolTest, EachIndexOnce) {
+  ThreadPool pool(4);
+  EXPECT_EQ(4, pool.num_threads());
+  for (size_t n : {1, 7, 1000}) {
+    std::vector<std::atomic<size_t>> hits(n);
+    pool.parallel_for(n, [&hits](size_t i) { ++hits[i]; });
+    for (size_t i = 0; i < n; ++i) {
+      EXPECT_EQ(1, hits[i]);
+    }
+  }
+}
+
+TEST(ThreadPoolTest, SlotsDoNotOverlap) {
+  ThreadPool pool(4);
+  std::vector<std::atomic<bool>> busy(pool.num_threads());
+  std::atomic<size_t> overlaps = 0, total = 0;
+  pool.parallel_for(1000, [&](size_t i, size_t slot) {
+    ASSERT_LT(slot, pool.num_threads());
+    if (busy[slot].exchange(true))
+      ++overlaps;
+    total += i;
+    busy[slot] = false;
+  });
+  EXPECT_EQ(0, overlaps);
+  EXPECT_EQ(999 * 1000 / 2, total);
+}
+
+} // namespace interval_mist::thread_pool